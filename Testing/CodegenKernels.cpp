@@ -0,0 +1,122 @@
+// Paired kernels for CodegenTest.py
+// Every metameasure_* function has a raw_* twin that does the same thing on plain numbers.
+// Both are compiled with optimizations and have to come out as the same instructions.
+
+#include <MetaMeasure.hpp>
+#include <MetaMeasure/Math.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+using namespace MetaMeasure;
+
+using Velocity = Measurement<double, UnitMeters<1>, UnitSeconds<-1>>;
+using Area = Measurement<double, UnitMeters<2>>;
+
+extern "C"
+{
+
+// Same unit addition
+void metameasure_add(const Meters<double>* a, const Meters<double>* b, Meters<double>* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+void raw_add(const double* a, const double* b, double* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+// Addition of a measurement in other units, through convertedValueOf
+void metameasure_add_converted(const Meters<double>* a, const Inches<double>* b, Meters<double>* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+void raw_add_converted(const double* a, const double* b, double* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i] * (127.0 / 5000.0);
+}
+
+// Unit conversion loop
+void metameasure_convert(const Inches<double>* in, Meters<double>* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = in[i];
+}
+
+void raw_convert(const double* in, double* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * (127.0 / 5000.0);
+}
+
+// Velocity from distance and time, through Quotient
+void metameasure_velocity(const Meters<double>* d, const Seconds<double>* t, Velocity* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = d[i] / t[i];
+}
+
+void raw_velocity(const double* d, const double* t, double* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = d[i] / t[i];
+}
+
+// Areas from lengths in different units, through Product
+void metameasure_area(const Meters<double>* a, const Inches<double>* b, Area* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+}
+
+void raw_area(const double* a, const double* b, double* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] * b[i] * (127.0 / 5000.0);
+}
+
+// Dot product
+Area metameasure_dot(const Meters<double>* a, const Meters<double>* b, std::size_t n)
+{
+  Area sum = 0.0;
+  for (std::size_t i = 0; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+double raw_dot(const double* a, const double* b, std::size_t n)
+{
+  double sum = 0.0;
+  for (std::size_t i = 0; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+// Scaling by a plain number
+void metameasure_scale(const Meters<float>* in, Meters<float>* out, float factor, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * factor;
+}
+
+void raw_scale(const float* in, float* out, float factor, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * factor;
+}
+
+// Side of a square from its area, through pow<1, 2>
+void metameasure_sqrt(const Area* in, Meters<double>* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = sqrt(in[i]);
+}
+
+void raw_sqrt(const double* in, double* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = std::sqrt(in[i]);
+}
+
+// Cube through pow<3>, which should be 2 multiplies rather than a call to std::pow
+void metameasure_cube(const Meters<double>* in, Measurement<double, UnitMeters<3>>* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = pow<3>(in[i]);
+}
+
+void raw_cube(const double* in, double* out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * in[i] * in[i];
+}
+
+}
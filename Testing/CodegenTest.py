@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# Checks that measurements cost nothing compared to plain numbers.
+#
+# Compiles Testing/CodegenKernels.cpp to assembly, and compares every metameasure_* kernel to its raw_* twin.
+# A pair fails if the measurement kernel has different arithmetic instructions (an extra multiply or divide, a call),
+# More instructions overall than the raw one plus a small tolerance,
+# Or if the raw kernel is vectorized and the measurement one isn't.
+# The tolerance is there because the compiler can pick a different register or block layout for 2 identical loops.
+# Exits with 1 if any pair fails, so it can be run as a test.
+#
+# Usage:
+#   python3 Testing/CodegenTest.py --compiler g++ --flags="-O2"
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+INCLUDE = os.path.join(ROOT, "include")
+KERNELS = os.path.join(ROOT, "Testing", "CodegenKernels.cpp")
+
+# Packed SIMD instructions on x86 (SSE/AVX) and AArch64 (NEON/SVE)
+VECTOR_INSTRUCTION = re.compile(r"^v?\w+p[sd]\b|\bv\d+\.\d+[sd]\b|\bz\d+\.[sd]\b")
+
+# Instructions that do actual work, as opposed to moving things around
+ARITHMETIC_INSTRUCTION = re.compile(r"^(v?(add|sub|mul|div|sqrt|fmadd|fmsub|fnmadd|fnmsub)\w*|f(add|sub|mul|div|sqrt|madd|msub)\w*|i?div\w*|call\w*|bl)$")
+
+
+def compile_to_assembly(compiler, flags):
+    command = [compiler, "-std=c++20", "-I" + INCLUDE, "-S", KERNELS, "-o", "-",
+               "-fno-asynchronous-unwind-tables"] + flags
+    result = subprocess.run(command, capture_output=True, text=True)
+
+    if result.returncode != 0:
+        raise RuntimeError("compilation failed:\n" + result.stderr)
+
+    return result.stdout
+
+
+def functions(assembly):
+    # Splits the assembly into the instructions of each function
+    # Labels, directives and comments aren't instructions; local labels stay part of the function they're in
+    bodies = {}
+    current = None
+
+    for line in assembly.splitlines():
+        line = line.split("#")[0].split("//")[0].rstrip()
+        if not line:
+            continue
+
+        label = re.match(r"^_?([A-Za-z_]\w*):", line)
+        if label:
+            current = bodies.setdefault(label.group(1), [])
+            continue
+
+        stripped = line.strip()
+        if current is None or stripped.startswith(".") or stripped.endswith(":"):
+            continue
+
+        current.append(stripped)
+
+    return bodies
+
+
+def vectorized(instructions):
+    return any(VECTOR_INSTRUCTION.search(i) for i in instructions)
+
+
+def arithmetic(instructions):
+    # How many times each arithmetic instruction appears
+    counts = collections.Counter()
+    for instruction in instructions:
+        mnemonic = instruction.split()[0]
+        if ARITHMETIC_INSTRUCTION.match(mnemonic):
+            counts[mnemonic] += 1
+    return counts
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compares the code generated for measurements and plain numbers.")
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--flags", default="-O2", help="extra compiler flags, space separated (use --flags=\"...\")")
+    parser.add_argument("--tolerance", type=int, default=2,
+                        help="how many more instructions a measurement kernel may have than its raw twin")
+    parser.add_argument("--verbose", action="store_true", help="print the instructions of failing kernels")
+    args = parser.parse_args()
+
+    bodies = functions(compile_to_assembly(args.compiler, args.flags.split()))
+    pairs = sorted(name[len("metameasure_"):] for name in bodies if name.startswith("metameasure_"))
+
+    if not pairs:
+        print("No kernels found in the assembly")
+        return 1
+
+    failures = 0
+    for pair in pairs:
+        measured = bodies["metameasure_" + pair]
+        raw = bodies.get("raw_" + pair)
+
+        problems = []
+        if raw is None:
+            problems.append("no raw_{} kernel".format(pair))
+        else:
+            if arithmetic(measured) != arithmetic(raw):
+                extra = arithmetic(measured) - arithmetic(raw)
+                missing = arithmetic(raw) - arithmetic(measured)
+                problems.append("arithmetic differs (extra: {}, missing: {})".format(dict(extra), dict(missing)))
+            if len(measured) > len(raw) + args.tolerance:
+                problems.append("{} instructions instead of {}".format(len(measured), len(raw)))
+            if vectorized(raw) and not vectorized(measured):
+                problems.append("not vectorized")
+
+        status = "FAIL" if problems else "ok"
+        counts = "" if raw is None else "{}/{} instructions".format(len(measured), len(raw))
+        print("{:<16} {:<4} {:<20} {}".format(pair, status, counts, "; ".join(problems)))
+
+        if problems:
+            failures += 1
+            if args.verbose and raw is not None:
+                print("  measurement:\n    " + "\n    ".join(measured))
+                print("  raw:\n    " + "\n    ".join(raw))
+
+    print("{} of {} kernels match".format(len(pairs) - failures, len(pairs)))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
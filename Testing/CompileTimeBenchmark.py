@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+# Measures how much MetaMeasure costs at compile time.
+#
+# Generates synthetic translation units of increasing size, compiles each of them,
+# And writes the wall time, peak compiler memory and template instantiation cost to a JSON report.
+# With clang, instantiations are counted from -ftime-trace; with GCC, -ftime-report gives the time spent on them.
+#
+# Usage:
+#   python3 Testing/CompileTimeBenchmark.py --compiler g++ --output compile_time.json
+#
+# Cases:
+#   products  - N distinct unit products (every one is a different Measurement type)
+#   chains    - One chain of N alternating operator* and operator/
+#   dimensions - N expressions that use all 7 SI dimensions at once
+#   literals  - Every literal suffix the library defines, N times over
+
+import argparse
+import glob
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+INCLUDE = os.path.join(ROOT, "include")
+
+PREFIXES = ["E", "P", "T", "G", "M", "k", "h", "da", "d", "c", "m", "u", "n", "p", "f", "a"]
+
+SI_UNITS = ["UnitMeters", "UnitGrams", "UnitSeconds", "UnitKelvins", "UnitAmperes", "UnitCandelas", "UnitMoles"]
+SI_TYPES = ["Meters", "Grams", "Seconds", "Kelvins", "Amperes", "Candelas", "Moles"]
+
+HEADER = """#include <MetaMeasure.hpp>
+
+using namespace MetaMeasure;
+
+"""
+
+
+def literal_suffixes():
+    # Read the suffixes straight out of the headers, so new units get benchmarked automatically
+    # Each suffix is paired with the literal namespace it's in, since some suffixes (like _nm) exist in more than one
+    # Headers list their literals in a METAMEASURE_*_LITERALS macro, which is then expanded inside the namespace
+    sets = {}
+    used = []
+    suffixes = []
+    for path in sorted(glob.glob(os.path.join(INCLUDE, "**", "*.hpp"), recursive=True)):
+        with open(path) as f:
+            text = f.read()
+
+        namespace = None
+        current_set = None
+        for line in text.splitlines():
+            defined = re.match(r"#define\s+(METAMEASURE_\w+_LITERALS)\b", line)
+            if defined:
+                current_set = sets.setdefault(defined.group(1), [])
+                continue
+            if line.startswith("#") or line.startswith("//"):
+                current_set = None
+                continue
+
+            declared = re.match(r"\s*namespace\s+(\w*Literals)\b", line)
+            if declared:
+                namespace = declared.group(1)
+                continue
+
+            plain = re.match(r"\s*METAMEASURE_LITERAL\(\s*[\w:]+\s*,\s*-?\d+\s*,\s*(_\w+)\s*\)", line)
+            prefixed = re.match(r"\s*METAMEASURE_LITERAL_WITH_METRIC_PREFIXES(?:_IN\(\s*[\w:]*\s*,|\()\s*\w+\s*,\s*-?\d+\s*,\s*(\w+)\s*\)", line)
+            expanded = re.match(r"\s*(METAMEASURE_\w+_LITERALS)\s*;", line)
+
+            found = []
+            if plain:
+                found = [plain.group(1)]
+            elif prefixed:
+                found = ["_" + p + prefixed.group(1) for p in PREFIXES]
+            elif expanded and current_set is None:
+                used.append((namespace, expanded.group(1)))
+
+            if current_set is not None:
+                current_set.extend(found)
+                if not line.rstrip().endswith("\\"):
+                    current_set = None
+            else:
+                suffixes.extend((namespace, suffix) for suffix in found)
+
+    for namespace, name in used:
+        suffixes.extend((namespace, suffix) for suffix in sets[name])
+
+    # Keep the first occurrence of each, in the order they were declared
+    return list(dict.fromkeys(suffixes))
+
+
+def exponents(i, count):
+    # Spreads i over count dimensions, with exponents in [-2, 2] and never all zero
+    result = []
+    i += 1
+    for _ in range(count):
+        result.append(i % 5 - 2)
+        i //= 5
+    if all(e == 0 for e in result):
+        result[0] = 1
+    return result
+
+
+def measurement_type(exps):
+    units = ", ".join("{}<{}>".format(SI_UNITS[d], e) for d, e in enumerate(exps) if e != 0)
+    return "Measurement<double, {}>".format(units)
+
+
+def generate_products(n):
+    body = []
+    for i in range(n):
+        a = exponents(i, 3)
+        b = exponents(i * 7 + 3, 3)
+        body.append("  {{ {} a(1.0); {} b(2.0); auto r = a * b; auto q = a / b; (void)r; (void)q; }}"
+                    .format(measurement_type(a), measurement_type(b)))
+    return HEADER + "int main()\n{\n" + "\n".join(body) + "\n}\n"
+
+
+def generate_chains(n):
+    lines = ["  Meters<double> m(2.0);", "  Seconds<double> s(3.0);", "  auto r0 = m * s;"]
+    for i in range(1, n + 1):
+        op = "/" if i % 2 else "*"
+        operand = ["m", "s"][(i // 2) % 2]
+        lines.append("  auto r{} = r{} {} {};".format(i, i - 1, op, operand))
+    lines.append("  (void)r{};".format(n))
+    return HEADER + "int main()\n{\n" + "\n".join(lines) + "\n}\n"
+
+
+def generate_dimensions(n):
+    body = []
+    for i in range(n):
+        exps = exponents(i + 1, 7)
+        factors = " * ".join("{}<double>({}.0)".format(SI_TYPES[d], d + 1) for d in range(7))
+        body.append("  {{ auto all = {}; {} x(1.0); auto r = all * x; (void)r; }}"
+                    .format(factors, measurement_type(exps)))
+    return HEADER + "int main()\n{\n" + "\n".join(body) + "\n}\n"
+
+
+def generate_literals(n):
+    suffixes = literal_suffixes()
+    body = []
+    for i in range(n):
+        for j, (namespace, suffix) in enumerate(suffixes):
+            body.append("  {{ using namespace MetaMeasure::{}; auto l{}_{} = {}.0{}; (void)l{}_{}; }}"
+                        .format(namespace, i, j, i + 1, suffix, i, j))
+    return HEADER + "int main()\n{\n" + "\n".join(body) + "\n}\n"
+
+
+CASES = {
+    "products": generate_products,
+    "chains": generate_chains,
+    "dimensions": generate_dimensions,
+    "literals": generate_literals,
+}
+
+
+def count_instantiations(trace_path):
+    # Only clang's -ftime-trace output has instantiation events
+    try:
+        with open(trace_path) as f:
+            trace = json.load(f)
+    except (OSError, ValueError):
+        return None
+
+    counts = {"classes": 0, "functions": 0}
+    for event in trace.get("traceEvents", []):
+        if event.get("name") == "InstantiateClass":
+            counts["classes"] += 1
+        elif event.get("name") == "InstantiateFunction":
+            counts["functions"] += 1
+    return counts
+
+
+def template_seconds(time_report):
+    # GCC has no instantiation counts, but -ftime-report does say how long instantiating took
+    match = re.search(r"^\s*template instantiation\s*:\s*([\d.]+)", time_report, re.MULTILINE)
+    return float(match.group(1)) if match else None
+
+
+def compile_once(compiler, flags, source, directory, clang):
+    obj = os.path.join(directory, "out.o")
+    command = [compiler, "-std=c++20", "-I" + INCLUDE, "-c", source, "-o", obj] + flags
+    command.append("-ftime-trace" if clang else "-ftime-report")
+
+    # Diagnostics go to a file rather than a pipe, since nothing reads a pipe while wait4 waits
+    # And a compiler that fills it would never exit
+    with tempfile.TemporaryFile(dir=directory) as errors:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=errors)
+        _, status, usage = os.wait4(process.pid, 0)
+        wall = time.perf_counter() - start
+
+        # wait4 already reaped it, so this just keeps Popen from trying again
+        process.returncode = os.waitstatus_to_exitcode(status)
+
+        errors.seek(0)
+        stderr = errors.read().decode(errors="replace")
+
+    if status != 0:
+        raise RuntimeError("compilation failed:\n" + stderr)
+
+    result = {
+        "wall_seconds": round(wall, 4),
+        # ru_maxrss is in kilobytes on Linux, but in bytes on macOS
+        "peak_memory_kb": usage.ru_maxrss // 1024 if sys.platform == "darwin" else usage.ru_maxrss,
+        "object_bytes": os.path.getsize(obj),
+        "instantiations": None,
+        "template_instantiation_seconds": None,
+    }
+
+    if clang:
+        result["instantiations"] = count_instantiations(os.path.splitext(obj)[0] + ".json")
+    else:
+        result["template_instantiation_seconds"] = template_seconds(stderr)
+
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measures MetaMeasure's compile-time cost.")
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--flags", default="-O2", help="extra compiler flags, space separated")
+    parser.add_argument("--sizes", default="8,32,128,512", help="comma separated list of N")
+    parser.add_argument("--cases", default=",".join(CASES), help="comma separated list of cases")
+    parser.add_argument("--repeat", type=int, default=3, help="compilations per data point; the fastest is kept")
+    parser.add_argument("--output", default="compile_time.json")
+    args = parser.parse_args()
+
+    version = subprocess.run([args.compiler, "--version"], capture_output=True, text=True).stdout
+    clang = "clang" in version
+    flags = args.flags.split()
+
+    report = {
+        "compiler": args.compiler,
+        "compiler_version": version.splitlines()[0] if version else "",
+        "flags": flags,
+        "platform": platform.platform(),
+        "results": [],
+    }
+
+    with tempfile.TemporaryDirectory() as directory:
+        for case in args.cases.split(","):
+            for size in (int(s) for s in args.sizes.split(",")):
+                source = os.path.join(directory, "{}_{}.cpp".format(case, size))
+                with open(source, "w") as f:
+                    f.write(CASES[case](size))
+
+                runs = [compile_once(args.compiler, flags, source, directory, clang) for _ in range(args.repeat)]
+                best = min(runs, key=lambda r: r["wall_seconds"])
+                best["peak_memory_kb"] = max(r["peak_memory_kb"] for r in runs)
+                best.update(case=case, size=size)
+                report["results"].append(best)
+
+                print("{:<10} N={:<6} {:>8.3f} s {:>10} KB".format(case, size, best["wall_seconds"], best["peak_memory_kb"]))
+
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2)
+
+    print("Report written to " + args.output)
+
+
+if __name__ == "__main__":
+    main()
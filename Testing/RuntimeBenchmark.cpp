@@ -0,0 +1,257 @@
+// Measures how fast measurements are at runtime, next to the same loops on plain numbers
+//
+// Every case runs a loop over arrays of measurements and the same loop over plain numbers (the baseline),
+// For float, double, long double and int64_t, and for each array size.
+// The results are written as JSON, so they can be compared between releases.
+//
+// Build it with optimizations, like the code that would use MetaMeasure:
+//   g++ -std=c++20 -O2 -Iinclude Testing/RuntimeBenchmark.cpp -o runtime_benchmark
+//   ./runtime_benchmark --sizes 1000,1000000 --min-time 0.2 --output runtime.json
+
+#include <MetaMeasure.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace MetaMeasure
+{
+
+namespace Benchmarks
+{
+
+// Literals that take on the value type of the measurements they're used with
+namespace BenchmarkLiterals
+{
+
+using MetaMeasureLiteralMode = LiteralModes::Adaptive;
+METAMEASURE_SI_LENGTH_LITERALS;
+METAMEASURE_SI_TIME_LITERALS;
+
+}
+
+using namespace BenchmarkLiterals;
+
+template<typename T>
+using Area = Measurement<T, UnitMeters<2>>;
+
+template<typename T>
+using Velocity = Measurement<T, UnitMeters<1>, UnitSeconds<-1>>;
+
+struct Options
+{
+  std::vector<std::size_t> sizes = {1000, 10000, 100000, 1000000, 10000000, 100000000};
+  double minTime = 0.1;
+  std::string output = "runtime.json";
+};
+
+struct Result
+{
+  std::string name;
+  std::string type;
+  std::size_t size;
+  double measurementNs;
+  double rawNs;
+};
+
+// Keeps the compiler from throwing away loops whose results are never read
+inline void keep(const void* p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(p) : "memory");
+#else
+  static const void* volatile sink;
+  sink = p;
+#endif
+}
+
+template<typename T>
+const char* typeName()
+{
+  if constexpr (std::is_same_v<T, float>) return "float";
+  else if constexpr (std::is_same_v<T, double>) return "double";
+  else if constexpr (std::is_same_v<T, long double>) return "long double";
+  else return "int64";
+}
+
+// Runs kernel over arrays of In1, In2 and Out until minTime has passed, and gives back the best time per element
+template<typename In1, typename In2, typename Out, typename Kernel>
+double time(std::size_t size, double minTime, Kernel kernel)
+{
+  // Values start at 1, so nothing divides by 0
+  std::vector<In1> a(size, In1(3));
+  std::vector<In2> b(size, In2(2));
+  std::vector<Out> out(size);
+
+  double best = 1e300;
+  double total = 0;
+
+  do
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    kernel(a.data(), b.data(), out.data(), size);
+    keep(out.data());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    best = std::min(best, seconds);
+    total += seconds;
+  }
+  while (total < minTime);
+
+  return best * 1e9 / static_cast<double>(size);
+}
+
+// Times a case that has a measurement version and a raw version
+// M1, M2 and MOut are the measurement types, the raw version uses their value types
+template<typename M1, typename M2, typename MOut, typename MeasurementKernel, typename RawKernel>
+void run(const char* name, const Options& options, std::vector<Result>& results,
+         MeasurementKernel measurementKernel, RawKernel rawKernel)
+{
+  using T = typename M1::ValueType;
+
+  for (std::size_t size : options.sizes)
+  {
+    try
+    {
+      Result result;
+      result.name = name;
+      result.type = typeName<T>();
+      result.size = size;
+      result.rawNs = Benchmarks::time<T, T, T>(size, options.minTime, rawKernel);
+      result.measurementNs = Benchmarks::time<M1, M2, MOut>(size, options.minTime, measurementKernel);
+      results.push_back(result);
+
+      std::cerr << name << " (" << result.type << ", " << size << "): "
+                << result.measurementNs << " ns vs " << result.rawNs << " ns per element" << std::endl;
+    }
+    catch (const std::bad_alloc&)
+    {
+      std::cerr << name << " (" << typeName<T>() << ", " << size << "): skipped, not enough memory" << std::endl;
+    }
+  }
+}
+
+// The factor raw numbers are scaled by, with integers multiplied before they're divided like measurements are
+template<typename T>
+T scale(T value, std::intmax_t num, std::intmax_t den)
+{
+  if constexpr (std::is_integral_v<T>) return value * num / den;
+  else return value * (static_cast<T>(num) / static_cast<T>(den));
+}
+
+template<typename T>
+void runAll(const Options& options, std::vector<Result>& results)
+{
+  run<Meters<T>, Meters<T>, Meters<T>>("add", options, results,
+    [](const Meters<T>* a, const Meters<T>* b, Meters<T>* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i]; },
+    [](const T* a, const T* b, T* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i]; });
+
+  run<Inches<T>, Inches<T>, Meters<T>>("convert_inches_to_meters", options, results,
+    [](const Inches<T>* a, const Inches<T>*, Meters<T>* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = a[i]; },
+    [](const T* a, const T*, T* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = scale(a[i], 127, 5000); });
+
+  run<Kilometers<T>, Kilometers<T>, Millimeters<T>>("convert_kilometers_to_millimeters", options, results,
+    [](const Kilometers<T>* a, const Kilometers<T>*, Millimeters<T>* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = a[i]; },
+    [](const T* a, const T*, T* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = scale(a[i], 1000000, 1); });
+
+  run<Meters<T>, Inches<T>, Area<T>>("product", options, results,
+    [](const Meters<T>* a, const Inches<T>* b, Area<T>* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] * b[i]; },
+    [](const T* a, const T* b, T* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = scale(a[i] * b[i], 127, 5000); });
+
+  run<Meters<T>, Seconds<T>, Velocity<T>>("quotient", options, results,
+    [](const Meters<T>* a, const Seconds<T>* b, Velocity<T>* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] / b[i]; },
+    [](const T* a, const T* b, T* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] / b[i]; });
+
+  run<Meters<T>, Seconds<T>, Velocity<T>>("literals", options, results,
+    [](const Meters<T>* a, const Seconds<T>* b, Velocity<T>* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = (a[i] + 2_km) / (b[i] + 500_ms); },
+    [](const T* a, const T* b, T* out, std::size_t n)
+    { for (std::size_t i = 0; i < n; ++i) out[i] = (a[i] + T(2000)) / (b[i] + scale(T(500), 1, 1000)); });
+}
+
+std::vector<std::size_t> parseSizes(const char* list)
+{
+  std::vector<std::size_t> sizes;
+  std::stringstream stream(list);
+  std::string size;
+
+  while (std::getline(stream, size, ','))
+  {
+    sizes.push_back(static_cast<std::size_t>(std::strtoull(size.c_str(), nullptr, 10)));
+  }
+
+  return sizes;
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results)
+{
+  out << "{\n  \"results\": [\n";
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    const Result& r = results[i];
+    out << "    {\"case\": \"" << r.name << "\", \"type\": \"" << r.type << "\", \"size\": " << r.size
+        << ", \"measurement_ns_per_element\": " << r.measurementNs
+        << ", \"raw_ns_per_element\": " << r.rawNs
+        << ", \"measurement_elements_per_second\": " << 1e9 / r.measurementNs
+        << ", \"raw_elements_per_second\": " << 1e9 / r.rawNs
+        << ", \"ratio\": " << r.measurementNs / r.rawNs << "}"
+        << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+
+  out << "  ]\n}\n";
+}
+
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  using namespace MetaMeasure::Benchmarks;
+
+  Options options;
+
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    if (std::strcmp(argv[i], "--sizes") == 0) options.sizes = parseSizes(argv[i + 1]);
+    else if (std::strcmp(argv[i], "--min-time") == 0) options.minTime = std::atof(argv[i + 1]);
+    else if (std::strcmp(argv[i], "--output") == 0) options.output = argv[i + 1];
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [--sizes 1000,1000000] [--min-time seconds] [--output file]" << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<Result> results;
+  runAll<float>(options, results);
+  runAll<double>(options, results);
+  runAll<long double>(options, results);
+  runAll<std::int64_t>(options, results);
+
+  std::ofstream out(options.output);
+  writeJson(out, results);
+  std::cerr << "Report written to " << options.output << std::endl;
+}
@@ -1,8 +1,26 @@
 #define METAMEASURE_SUPPRESS_CONVERSION_WARNINGS
 #include <MetaMeasure.hpp>
+#include <MetaMeasure/Array.hpp>
+#include <MetaMeasure/Batch.hpp>
+#include <MetaMeasure/Binary.hpp>
+#include <MetaMeasure/Compact.hpp>
+#include <MetaMeasure/Dynamic.hpp>
+#include <MetaMeasure/Format.hpp>
+#include <MetaMeasure/Math.hpp>
+#include <MetaMeasure/Mapped.hpp>
+#include <MetaMeasure/Parse.hpp>
+#include <MetaMeasure/Reduce.hpp>
+#include <MetaMeasure/Table.hpp>
+#include <MetaMeasure/Vector.hpp>
 
 #include <fstream>
+#include <bit>
+#include <cmath>
 #include <complex>
+#include <cstdio>
+#include <cstdint>
+#include <string_view>
+#include <vector>
 
 namespace MetaMeasure
 {
@@ -13,6 +31,16 @@ namespace Tests
 using namespace MetricLiterals;
 using namespace CustomaryLiterals;
 
+// Literals that take on the value type of whatever they're used with
+namespace AdaptiveLiterals
+{
+
+using MetaMeasureLiteralMode = LiteralModes::Adaptive;
+METAMEASURE_SI_LENGTH_LITERALS;
+METAMEASURE_SI_TIME_LITERALS;
+
+}
+
 template<typename T>
 using Velocity = Measurement<T, UnitMeters<1>, UnitSeconds<-1>>;
 
@@ -69,6 +97,580 @@ void copyConversion(std::ostream& out)
   out << std::endl;
 }
 
+void conversionFactors(std::ostream& out)
+{
+  out << "Testing precomputed conversion factors:" << std::endl;
+
+  constexpr Rational InchesPerMeter = Private::ConversionRatio<Meters<float>::Dimensions, Inches<float>::Dimensions>;
+  constexpr Rational MetersPerMeter = Private::ConversionRatio<Meters<float>::Dimensions, Meters<float>::Dimensions>;
+  Inches<float> a = Meters<float>(2.f);
+  Centimeters<int> b = Meters<int>(3);
+
+  out << "InchesPerMeter as float = " << Private::ConversionFactor<float, InchesPerMeter> << "; should be 39.3701" << std::endl;
+  out << "MetersPerMeter is 1: " << (MetersPerMeter == Rational()) << "; should be 1" << std::endl;
+  out << "a = " << a.value() << " in; should be 78.7402 in" << std::endl;
+  out << "b = " << b.value() << " cm; should be 300 cm" << std::endl;
+  out << std::endl;
+}
+
+void integerConversion(std::ostream& out)
+{
+  out << "Testing exact integer conversions:" << std::endl;
+
+  // 9e18 ns * 1/1000 would overflow if it was multiplied before dividing
+  auto a = convert<Microseconds<long long>>(Nanoseconds<long long>(9000000000000000000LL));
+  auto b = convert<Kilometers<int>, Rounding::Nearest>(Meters<int>(-1500));
+  auto c = convert<Kilometers<int>, Rounding::Floor>(Meters<int>(-1));
+  auto d = convert<Millimeters<int>, Rounding::Truncate, Overflow::Saturate>(Kilometers<int>(3000000));
+
+  // 3000 km * 3000000 m is past an int before it's scaled into square kilometers, but not after
+  auto e = Kilometers<int>(3000) * Meters<int>(3000000);
+  auto f = Meters<int>(2000000000) / Kilometers<int>(2000000);
+
+  out << "a = " << a.value() << " us; should be 9000000000000000 us" << std::endl;
+  out << "b = " << b.value() << " km; should be -2 km" << std::endl;
+  out << "c = " << c.value() << " km; should be -1 km" << std::endl;
+  out << "d = " << d.value() << " mm; should be 2147483647 mm" << std::endl;
+  out << "e = " << e.value() << " km^2; should be 9000000 km^2" << std::endl;
+  out << "f = " << f << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void floatToIntegerConversion(std::ostream& out)
+{
+  out << "Testing conversions from floating point into integer measurements:" << std::endl;
+
+  // These are scaled before they're rounded, so nothing is cut off first
+  auto a = convert<Millimeters<int>>(Meters<double>(1.5));
+  auto b = convert<Millimeters<int>, Rounding::Nearest>(Meters<double>(1.0006));
+  auto c = convert<Millimeters<int>, Rounding::Floor>(Meters<double>(-0.0005));
+  auto d = convert<Millimeters<int>, Rounding::Truncate, Overflow::Saturate>(Kilometers<double>(3000.0));
+
+  out << "a = " << a.value() << " mm; should be 1500 mm" << std::endl;
+  out << "b = " << b.value() << " mm; should be 1001 mm" << std::endl;
+  out << "c = " << c.value() << " mm; should be -1 mm" << std::endl;
+  out << "d = " << d.value() << " mm; should be 2147483647 mm" << std::endl;
+  out << std::endl;
+}
+
+void wideRatios(std::ostream& out)
+{
+  out << "Testing conversions with ratios past 64 bits:" << std::endl;
+
+  // A cubic nanometer is 1e-27 cubic meters, which doesn't fit in a std::ratio
+  Nanometers<double, 3> a = Kilometers<double, 3>(1.0);
+  Nanometers<double, 3> b = Inches<double, 3>(1.0);
+
+  out << "a = " << a.value() << " nm^3; should be 1e+36 nm^3" << std::endl;
+  out << "b = " << b.value() << " nm^3; should be 1.6387e+22 nm^3" << std::endl;
+  out << std::endl;
+}
+
+void batchConversion(std::ostream& out)
+{
+  out << "Testing conversions of whole spans:" << std::endl;
+
+  // 19 elements, so the kernels have a tail to do too
+  std::vector<Inches<float>> a(19, Inches<float>(10.f));
+  std::vector<Meters<float>> b(a.size());
+  std::vector<Millimeters<std::int32_t>> c(a.size());
+  convert<Meters<float>>(std::span(a), std::span(b));
+  convert<Millimeters<std::int32_t>, Rounding::Nearest>(std::span(a), std::span(c));
+  auto d = convertInPlace<Centimeters<float>>(std::span(a));
+
+  // Values that don't fit in an int32_t, in a kernel's lanes (0 and 1) and in its tail (17 and 18)
+  std::vector<Meters<float>> huge(19, Meters<float>(1.f));
+  huge[0] = huge[18] = Meters<float>(3e6f);
+  huge[1] = huge[17] = Meters<float>(-3e6f);
+  std::vector<Millimeters<std::int32_t>> saturated(huge.size());
+  convert<Millimeters<std::int32_t>, Rounding::Truncate, Overflow::Saturate>(std::span(huge), std::span(saturated));
+
+  bool overflowThrew = false;
+
+  try
+  {
+    convert<Millimeters<std::int32_t>, Rounding::Truncate, Overflow::Checked>(std::span(huge), std::span(saturated));
+  }
+  catch (const std::overflow_error&)
+  {
+    overflowThrew = true;
+  }
+
+  out << "b[18] = " << b[18].value() << " m; should be 0.254 m" << std::endl;
+  out << "c[18] = " << c[18].value() << " mm; should be 254 mm" << std::endl;
+  out << "d[18] = " << d[18].value() << " cm; should be 25.4 cm" << std::endl;
+  out << "saturated[0], [18] = " << saturated[0].value() << ", " << saturated[18].value()
+      << " mm; should be 2147483647, 2147483647 mm" << std::endl;
+  out << "saturated[1], [17] = " << saturated[1].value() << ", " << saturated[17].value()
+      << " mm; should be -2147483648, -2147483648 mm" << std::endl;
+  out << "overflowThrew = " << overflowThrew << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void measurementArrays(std::ostream& out)
+{
+  out << "Testing arithmetic on whole arrays of measurements:" << std::endl;
+
+  MeasurementArray<double, UnitMeters<1>> a(19, Meters<double>(2.0));
+  MeasurementArray<double, UnitInches<1>> b(19, Inches<double>(10.0));
+  a[18] = 3.0_m;
+
+  MeasurementArray<double, UnitMeters<1>> sum = a + b;
+  MeasurementArray<double, UnitMeters<2>> area = a * b;
+  std::vector<double> ratio = b / a;
+  auto speed = (3.0 * a / Seconds<double>(2.0)).eval();
+  a -= b;
+
+  bool aligned = reinterpret_cast<std::uintptr_t>(sum.data()) % CacheLineSize == 0;
+
+  out << "sum[18] = " << sum[18].value() << " m; should be 3.254 m" << std::endl;
+  out << "area[18] = " << area[18].value() << " m^2; should be 0.762 m^2" << std::endl;
+  out << "ratio[18] = " << ratio[18] << "; should be 0.0846667" << std::endl;
+  out << "speed[18] = " << speed[18].value() << " m/s; should be 4.5 m/s" << std::endl;
+  out << "a[0] = " << a[0].value() << " m; should be 1.746 m" << std::endl;
+  out << "sum is aligned to a cache line = " << aligned << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void expressions(std::ostream& out)
+{
+  out << "Testing expressions that are evaluated all at once:" << std::endl;
+
+  using AreaPerTime = Measurement<double, UnitMeters<2>, UnitSeconds<-1>>;
+
+  Meters<double> a(2.0);
+  Inches<double> b(10.0);
+  Seconds<double> c(4.0);
+  Measurement<double, UnitCentimeters<2>, UnitSeconds<-1>> d(10.0);
+
+  AreaPerTime eager = a * b / c + d;
+  AreaPerTime fused = lazy(a) * b / c + d;
+
+  MeasurementArray<double, UnitMeters<1>> as(19, a);
+  MeasurementArray<double, UnitInches<1>> bs(19, b);
+  MeasurementArray<double, UnitSeconds<1>> cs(19, c);
+  MeasurementArray<double, UnitMillimeters<2>, UnitMilliseconds<-1>> es = as * bs / cs + d;
+
+  // The arrays an expression reads can also be the one it's assigned to
+  as = as * 2.0 + bs;
+
+  out << "eager = " << eager.value() << " m^2/s; should be 0.128 m^2/s" << std::endl;
+  out << "fused = " << fused.value() << " m^2/s; should be 0.128 m^2/s" << std::endl;
+  out << "es[18] = " << es[18].value() << " mm^2/ms; should be 128 mm^2/ms" << std::endl;
+  out << "as[18] = " << as[18].value() << " m; should be 4.254 m" << std::endl;
+  out << std::endl;
+}
+
+void measurementTables(std::ostream& out)
+{
+  out << "Testing tables of measurements stored by column:" << std::endl;
+
+  enum Columns { PositionColumn, VelocityColumn, MassColumn, TimeColumn };
+  MeasurementTable<Meters<double>, Velocity<double>, Kilograms<double>, Seconds<double>> table;
+  table.reserve(3);
+  table.append(1.0_m, Velocity<double>(2.0), 3.0_kg, 0.0_s);
+  table.append(10.0_cm, Velocity<double>(4.0), 500.0_g, 0.0_s);
+  table.append(12.0_in, Velocity<double>(6.0), 2.0_kg, 0.0_s);
+
+  // One step of a simulation, only touching the columns it uses
+  Seconds<double> step(0.5);
+  table.column<PositionColumn>() += table.column<VelocityColumn>() * step;
+  table.column<TimeColumn>() += step;
+
+  double totalMass = 0;
+  for (double mass : table.values<MassColumn>()) totalMass += mass;
+
+  table[1].set(2.0_m, Velocity<double>(1.0), 1.0_kg, 1.0_s);
+
+  out << "table.size() = " << table.size() << "; should be 3" << std::endl;
+  out << "table[2].get<PositionColumn>() = " << table[2].get<PositionColumn>().value() << " m; should be 3.3048 m" << std::endl;
+  out << "table[2].get<TimeColumn>() = " << table[2].get<TimeColumn>().value() << " s; should be 0.5 s" << std::endl;
+  out << "totalMass = " << totalMass << " kg; should be 5.5 kg" << std::endl;
+  out << "table[1].get<MassColumn>() = " << table[1].get<MassColumn>().value() << " kg; should be 1 kg" << std::endl;
+  out << std::endl;
+}
+
+void parsing(std::ostream& out)
+{
+  out << "Testing parsing measurements from text:" << std::endl;
+
+  using Acceleration = Measurement<double, UnitFeet<1>, UnitSeconds<-2>>;
+
+  Meters<double> a = parse<Meters<double>>("3 ft");
+  Acceleration b = parse<Acceleration>(" 9.81 m/s^2 ");
+  Kilograms<double> c = parse<Kilograms<double>>("500g");
+  auto d = parse<Millimeters<std::int32_t>, Rounding::Nearest>("+1.5 in");
+
+  // Prefixes on Hz are on the whole symbol, so a kilohertz is 1000 per second
+  auto g = parse<Measurement<double, UnitSeconds<-1>>>("5 kHz");
+
+  // Whole numbers are read as integers and scaled exactly, so these aren't rounded to a double
+  auto h = parse<Nanometers<std::int64_t>>("9007199254740993 nm");
+  auto i = parse<Millimeters<std::int64_t>>("9007199254740993 m");
+  auto j = parse<Meters<std::int64_t>, Rounding::Nearest>("9007199254740993501 mm");
+
+  std::string_view lines = "1 km\r\n\n  2.5 cm\n3 ft\n4 m\n";
+  Meters<double> e[3];
+  BulkParseResult bulk = parseLines(lines, std::span(e));
+
+  Meters<double> f;
+  std::string_view wrong = "3 s";
+  ParseResult failed = fromChars(wrong.data(), wrong.data() + wrong.size(), f);
+
+  out << "a = " << a.value() << " m; should be 0.9144 m" << std::endl;
+  out << "b = " << b.value() << " ft/s^2; should be 32.185 ft/s^2" << std::endl;
+  out << "c = " << c.value() << " kg; should be 0.5 kg" << std::endl;
+  out << "d = " << d.value() << " mm; should be 38 mm" << std::endl;
+  out << "g = " << g.value() << " Hz; should be 5000 Hz" << std::endl;
+  out << "h = " << h.value() << " nm; should be 9007199254740993 nm" << std::endl;
+  out << "i = " << i.value() << " mm; should be 9007199254740993000 mm" << std::endl;
+  out << "j = " << j.value() << " m; should be 9007199254740994 m" << std::endl;
+  out << "bulk.count = " << bulk.count << "; should be 3" << std::endl;
+  out << "e[1] = " << e[1].value() << " m; should be 0.025 m" << std::endl;
+  out << "rest of lines = " << std::string_view(bulk.ptr, 3) << "; should be 4 m" << std::endl;
+  out << "failed.error is WrongDimensions = " << (failed.error == ParseError::WrongDimensions) << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void formatting(std::ostream& out)
+{
+  out << "Testing writing measurements as text:" << std::endl;
+
+  using Acceleration = Measurement<double, UnitMeters<1>, UnitSeconds<-2>>;
+
+  char a[32];
+  char* aEnd = toChars(a, a + sizeof(a), Acceleration(9.81)).ptr;
+
+  char b[32];
+  char* bEnd = toChars<SymbolStyles::Ascii>(b, b + sizeof(b), Acceleration(9.81), std::chars_format::fixed, 1).ptr;
+
+  char c[4];
+  std::to_chars_result tooSmall = toChars(c, c + sizeof(c), Millimeters<int>(42));
+
+  // "nm" reads back as nanometers, so nautical miles are written as a multiple of meters instead
+  char d[32];
+  char* dEnd = toChars<SymbolStyles::Ascii>(d, d + sizeof(d), NauticalMiles<double>(2.0)).ptr;
+  std::string_view nauticalMiles(d, dEnd - d);
+
+  char e[32];
+  char* eEnd = toChars<SymbolStyles::Ascii>(e, e + sizeof(e), Nanometers<double>(2.0)).ptr;
+  std::string_view nanometers(e, eEnd - e);
+
+  out << "a = " << std::string_view(a, aEnd - a) << "; should be 9.81 m\xC2\xB7s\xE2\x81\xBB\xC2\xB2" << std::endl;
+  out << "b = " << std::string_view(b, bEnd - b) << "; should be 9.8 m*s^-2" << std::endl;
+  out << "parse<Acceleration>(b) = " << parse<Acceleration>(std::string_view(b, bEnd - b)).value() << "; should be 9.8" << std::endl;
+  out << "unitSymbol<Kilograms<double>>() = " << unitSymbol<Kilograms<double>>() << "; should be kg" << std::endl;
+  out << "tooSmall.ec is value_too_large = " << (tooSmall.ec == std::errc::value_too_large) << "; should be 1" << std::endl;
+  out << "parse<NauticalMiles<double>>(" << nauticalMiles << ") = " << parse<NauticalMiles<double>>(nauticalMiles).value()
+      << "; should be 2" << std::endl;
+  out << "parse<Nanometers<double>>(" << nanometers << ") = " << parse<Nanometers<double>>(nanometers).value()
+      << "; should be 2" << std::endl;
+  out << std::endl;
+}
+
+void dynamicMeasurements(std::ostream& out)
+{
+  out << "Testing measurements with dimensions only known at runtime:" << std::endl;
+
+  DynamicMeasurement<> distance = 3.0_km;
+  DynamicMeasurement<> time = Seconds<double>(2.0);
+  DynamicMeasurement<> speed = distance / time;
+  DynamicMeasurement<> total = distance + 500.0_m;
+
+  bool mismatchThrew = false;
+
+  try
+  {
+    total = distance + time;
+  }
+  catch (const std::invalid_argument&)
+  {
+    mismatchThrew = true;
+  }
+
+  out << "speed.is<Velocity<double>>() = " << speed.is<Velocity<double>>() << "; should be 1" << std::endl;
+  out << "speed.as<Velocity<double>>() = " << speed.as<Velocity<double>>().value() << " m/s; should be 1500 m/s" << std::endl;
+  out << "total = " << total.value() << " km; should be 3.5 km" << std::endl;
+  out << "(speed * time).dimensions() == distance.dimensions() = " << ((speed * time).dimensions() == distance.dimensions()) << "; should be 1" << std::endl;
+  out << "(1.0 / time).dimensions().exponent(2) = " << (1.0 / time).dimensions().exponent(2) << "; should be -1" << std::endl;
+  out << "mismatchThrew = " << mismatchThrew << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void binaryEncoding(std::ostream& out)
+{
+  out << "Testing encoding measurements as binary:" << std::endl;
+
+  std::vector<Feet<float>> feet(19, Feet<float>(10.f));
+  alignas(CacheLineSize) std::byte buffer[encodedSize<Feet<float>>(19)];
+  std::size_t size = encode(std::span(feet), std::span(buffer));
+  std::span<const std::byte> bytes(buffer, size);
+
+  std::span<const Feet<float>> viewed = view<Feet<float>>(bytes);
+
+  std::vector<Meters<double>> meters(19);
+  std::size_t decoded = decode<Meters<double>, Inches<float>, Feet<float>>(bytes, meters);
+
+  bool wrongTypeThrew = false;
+
+  try
+  {
+    view<Meters<float>>(bytes);
+  }
+  catch (const std::invalid_argument&)
+  {
+    wrongTypeThrew = true;
+  }
+
+  // A header that says its values are 1 byte each, so 24 of them would fit in the 3 doubles that are there
+  std::vector<Feet<double>> few(3);
+  alignas(CacheLineSize) std::byte forged[encodedSize<Feet<double>>(3)];
+  encode(std::span(few), std::span(forged));
+  forged[5] = std::byte{1};
+  forged[16] = std::byte{24};
+
+  bool forgedSizeThrew = false;
+
+  try
+  {
+    view<Feet<double>>(forged);
+  }
+  catch (const std::invalid_argument&)
+  {
+    forgedSizeThrew = true;
+  }
+
+  out << "size = " << size << " bytes; should be 108 bytes" << std::endl;
+  out << "viewed.data() is in buffer = " << (static_cast<const void*>(viewed.data()) == buffer + BinaryHeaderSize) << "; should be 1" << std::endl;
+  out << "viewed[18] = " << viewed[18].value() << " ft; should be 10 ft" << std::endl;
+  out << "decoded = " << decoded << "; should be 19" << std::endl;
+  out << "meters[18] = " << meters[18].value() << " m; should be 3.048 m" << std::endl;
+  out << "wrongTypeThrew = " << wrongTypeThrew << "; should be 1" << std::endl;
+  out << "forgedSizeThrew = " << forgedSizeThrew << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void mappedFiles(std::ostream& out)
+{
+  out << "Testing mapping files of measurements:" << std::endl;
+
+  const char* path = "metameasure_mapped.bin";
+  std::vector<Meters<double>> meters;
+  for (int i = 0; i < 1000; ++i) meters.push_back(Meters<double>(i));
+
+  std::vector<std::byte> bytes(encodedSize<Meters<double>>(meters.size()));
+  encode(std::span(meters), std::span(bytes));
+  std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+  double sum = 0;
+  std::size_t size = 0;
+  bool wrongTypeThrew = false;
+
+  {
+    MappedMeasurements<Meters<double>> mapped(path, MappedAccess::Sequential);
+    mapped.willNeed(0, mapped.size());
+
+    for (std::size_t i = 0; i < mapped.size(); ++i)
+    {
+      if (i + 64 < mapped.size()) mapped.prefetch(i + 64);
+      sum += mapped[i].value();
+    }
+
+    MappedMeasurements<Meters<double>> moved = std::move(mapped);
+    size = moved.size() + mapped.size();
+
+    try
+    {
+      MappedMeasurements<Feet<double>> wrong(path);
+    }
+    catch (const std::invalid_argument&)
+    {
+      wrongTypeThrew = true;
+    }
+  }
+
+  // The same file with its last measurement cut off
+  std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size() - 1));
+
+  bool truncatedThrew = false;
+
+  try
+  {
+    MappedMeasurements<Meters<double>> truncated(path);
+  }
+  catch (const std::invalid_argument&)
+  {
+    truncatedThrew = true;
+  }
+
+  std::remove(path);
+
+  out << "size = " << size << "; should be 1000" << std::endl;
+  out << "sum = " << sum << " m; should be 499500 m" << std::endl;
+  out << "wrongTypeThrew = " << wrongTypeThrew << "; should be 1" << std::endl;
+  out << "truncatedThrew = " << truncatedThrew << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void reductions(std::ostream& out)
+{
+  out << "Testing reductions of measurements:" << std::endl;
+
+  std::vector<Meters<float>> readings(1000000, Meters<float>(0.1f));
+  std::span<const Meters<float>> span(readings);
+
+  auto naive = sum(span, Execution::Sequential(), Summation::Naive());
+  auto kahan = sum(span, Execution::Simd(), Summation::Kahan());
+  auto pairwise = sum(span, Execution::Parallel{4});
+  auto oneThread = sum(span, Execution::Deterministic{1});
+  auto threeThreads = sum(span, Execution::Deterministic{3});
+
+  readings[123] = Meters<float>(-2.f);
+  readings[456789] = Meters<float>(5.f);
+
+  std::vector<Meters<double>> l = {3., 4.};
+  std::vector<Kilometers<double>> r = {1., 2.};
+  Measurement<double, UnitMeters<2>> product = dot(std::span(l), std::span(r));
+
+  out << "naive sum = " << naive.value() << " m; should be far from 100000 m" << std::endl;
+  out << "kahan sum = " << kahan.value() << " m; should be 100000 m" << std::endl;
+  out << "pairwise sum = " << pairwise.value() << " m; should be 100000 m" << std::endl;
+  out << "deterministic sums are equal = " << (oneThread.value() == threeThreads.value()) << "; should be 1" << std::endl;
+  out << "min = " << min(span, Execution::Parallel()).value() << " m; should be -2 m" << std::endl;
+  out << "max = " << max(span).value() << " m; should be 5 m" << std::endl;
+  out << "mean = " << mean(std::span(l)).value() << " m; should be 3.5 m" << std::endl;
+  out << "dot = " << product.value() << " m^2; should be 11000 m^2" << std::endl;
+  out << "norm = " << norm(std::span(l)).value() << " m; should be 5 m" << std::endl;
+  out << std::endl;
+}
+
+void compactStorage(std::ostream& out)
+{
+  out << "Testing compact storage of measurements:" << std::endl;
+
+  using Ticks = Compact<Millimeters<float>, std::int16_t>;
+
+  Ticks distance = 1.2345_m;
+  Ticks clamped = Millimeters<float>(40000.f);
+  Compact<Millimeters<unsigned>, std::int8_t> small = Millimeters<unsigned>(5);
+  Compact<Millimeters<int>, std::uint8_t> negative = Millimeters<int>(-5);
+  auto sum = distance + 1.0_m;
+  distance += 1.0_mm;
+
+  std::vector<Kilometers<double>> kilometers = {1., 2., 3.};
+  std::vector<Compact<Meters<float>, BFloat16>> stored(3);
+  std::vector<Meters<float>> widened(3);
+  narrow(std::span(kilometers), std::span(stored));
+  widen(std::span(stored), std::span(widened));
+
+#ifdef __FLT16_MAX__
+  // Where the compiler has _Float16, Half gives the same bits for every half and the floats right next to them
+  int halfMismatches = 0;
+
+  for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+  {
+    float exact = static_cast<float>(std::bit_cast<_Float16>(static_cast<std::uint16_t>(bits)));
+    if (exact != exact) continue;
+
+    for (float f : {exact, std::nextafter(exact, -INFINITY), std::nextafter(exact, INFINITY)})
+    {
+      halfMismatches += Half(f).bits() != std::bit_cast<std::uint16_t>(static_cast<_Float16>(f));
+    }
+
+    halfMismatches += static_cast<float>(Half::fromBits(static_cast<std::uint16_t>(bits))) != exact;
+  }
+#endif
+
+  out << "sizeof(Ticks) = " << sizeof(Ticks) << "; should be 2" << std::endl;
+  out << "distance.stored() = " << distance.stored() << "; should be 1236" << std::endl;
+  out << "clamped.stored() = " << clamped.stored() << "; should be 32767" << std::endl;
+  out << "small.stored() = " << int(small.stored()) << "; should be 5" << std::endl;
+  out << "negative.stored() = " << int(negative.stored()) << "; should be 0" << std::endl;
+  out << "sum = " << sum.value() << " mm; should be 2235 mm" << std::endl;
+  out << "Half(0.1f) = " << static_cast<float>(Half(0.1f)) << "; should be 0.0999756" << std::endl;
+#ifdef __FLT16_MAX__
+  out << "halfMismatches with _Float16 = " << halfMismatches << "; should be 0" << std::endl;
+#endif
+  out << "widened[2] = " << widened[2].value() << " m; should be 3008 m" << std::endl;
+  out << std::endl;
+}
+
+void powersAndRoots(std::ostream& out)
+{
+  out << "Testing powers and roots of measurements:" << std::endl;
+
+  constexpr Measurement<double, UnitMeters<2>> area = 16.0;
+  constexpr Meters<double> side = sqrt(area);
+  constexpr Measurement<double, UnitMeters<3>> volume = pow<3>(side);
+  constexpr Measurement<double, UnitMeters<3>> halfPower = pow<3, 2>(area);
+
+  Measurement<double, UnitKilometers<2>> field = 9.0;
+  Kilometers<double> fieldSide = sqrt(field);
+
+  // Constant roots are correctly rounded, so they're the same as std::sqrt at runtime
+  constexpr Meters<double> constantRoot = sqrt(Measurement<double, UnitMeters<2>>(2.0));
+  constexpr Meters<double> constantCubeRoot = cbrt(Measurement<double, UnitMeters<3>>(10.0));
+  volatile double two = 2.0;
+  Meters<double> runtimeRoot = sqrt(Measurement<double, UnitMeters<2>>(two));
+
+  out << "side = " << side.value() << " m; should be 4 m" << std::endl;
+  out << "volume = " << volume.value() << " m^3; should be 64 m^3" << std::endl;
+  out << "halfPower = " << halfPower.value() << " m^3; should be 64 m^3" << std::endl;
+  out << "cbrt(volume) = " << cbrt(volume).value() << " m; should be 4 m" << std::endl;
+  out << "fieldSide = " << fieldSide.value() << " km; should be 3 km" << std::endl;
+  out << "hypot = " << hypot(Meters<double>(3.0), Kilometers<double>(0.004)).value() << " m; should be 5 m" << std::endl;
+  out << "constant sqrt(2 m^2) is the runtime one: " << (constantRoot == runtimeRoot) << "; should be 1" << std::endl;
+  out << "constant cbrt(10 m^3) is correctly rounded: " << (constantCubeRoot.value() == 0x1.13c484138704fp+1) << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void measurementVectors(std::ostream& out)
+{
+  out << "Testing vectors of measurements:" << std::endl;
+
+  using Velocity = Measurement<double, UnitMeters<1>, UnitSeconds<-1>>;
+
+  constexpr Vec3<Meters<double>> a(1.0, 2.0, 3.0);
+  constexpr Vec3<Meters<double>> b(Meters<double>(4.0), Kilometers<double>(0.005), Meters<double>(6.0));
+  constexpr Measurement<double, UnitMeters<2>> ab = dot(a, b);
+  constexpr Vec3<Measurement<double, UnitMeters<2>>> axb = cross(a, b);
+
+  Vec3<Velocity> velocity(3.0, 0.0, 4.0);
+  Vec3<Meters<double>> travelled = velocity * Seconds<double>(2.0);
+  Vec3<Kilometers<double>> inKilometers = a + b;
+  auto direction = velocity / norm(velocity);
+
+  out << "sizeof(Vec3<float>) = " << sizeof(Vec3<Meters<float>>) << ", alignof = " << alignof(Vec3<Meters<float>>)
+      << "; should be 16, 16" << std::endl;
+  out << "dot(a, b) = " << ab.value() << " m^2; should be 32 m^2" << std::endl;
+  out << "cross(a, b) = (" << axb.x().value() << ", " << axb.y().value() << ", " << axb.z().value()
+      << ") m^2; should be (-3, 6, -3) m^2" << std::endl;
+  out << "a + b = (" << inKilometers.x().value() << ", " << inKilometers.y().value() << ", " << inKilometers.z().value()
+      << ") km; should be (0.005, 0.007, 0.009) km" << std::endl;
+  out << "norm(velocity) = " << norm(velocity).value() << " m/s; should be 5 m/s" << std::endl;
+  out << "travelled = (" << travelled.x().value() << ", " << travelled.y().value() << ", " << travelled.z().value()
+      << ") m; should be (6, 0, 8) m" << std::endl;
+  out << "direction = (" << direction.x() << ", " << direction.y() << ", " << direction.z()
+      << "); should be (0.6, 0, 0.8)" << std::endl;
+
+  VectorBatch<Meters<double>, 3> positions;
+  VectorBatch<Meters<double>, 3> offsets;
+  positions.push_back(a);
+  positions.push_back(velocity * Seconds<double>(1.0));
+  offsets.push_back(b);
+  offsets.push_back(Vec3<Meters<double>>(0.0, 1.0, 0.0));
+
+  MeasurementArray<double, UnitMeters<2>> dots = dot(positions, offsets);
+  auto crosses = cross(positions, offsets);
+  auto lengths = norm(positions);
+
+  out << "dots = {" << dots[0].value() << ", " << dots[1].value() << "} m^2; should be {32, 0} m^2" << std::endl;
+  out << "crosses[1] = (" << crosses[1].x().value() << ", " << crosses[1].y().value() << ", " << crosses[1].z().value()
+      << ") m^2; should be (-4, 0, 3) m^2" << std::endl;
+  out << "lengths[1] = " << lengths[1].value() << " m; should be 5 m" << std::endl;
+  out << std::endl;
+}
+
 void addition(std::ostream& out)
 {
   out << "Testing addition of measurements:" << std::endl;
@@ -312,6 +914,41 @@ void differentDimensionDivision(std::ostream& out)
   out << std::endl;
 }
 
+void unitOrdering(std::ostream& out)
+{
+  out << "Testing that the order units are listed in doesn't matter:" << std::endl;
+
+  using A = Measurement<long double, UnitMeters<1>, UnitSeconds<-1>>;
+  using B = Measurement<long double, UnitSeconds<-1>, UnitMeters<1>>;
+  auto x = 10.0_m / 2.0_s;
+  auto y = (1.0L / 2.0_s) * 10.0_m;
+
+  out << "A and B are the same type: " << std::is_same_v<A, B> << "; should be 1" << std::endl;
+  out << "x and y are the same type: " << std::is_same_v<decltype(x), decltype(y)> << "; should be 1" << std::endl;
+  out << "A's first unit is length: " << std::is_same_v<std::tuple_element_t<0, A::UnitTuple>, UnitMeters<1>> << "; should be 1" << std::endl;
+  out << std::endl;
+}
+
+void adaptiveLiterals(std::ostream& out)
+{
+  out << "Testing literals that adopt the value type they're used with:" << std::endl;
+
+  using AdaptiveLiterals::operator""_km;
+  using AdaptiveLiterals::operator""_m;
+
+  Seconds<float> time = 4.0f;
+  Meters<float> x = 2.5_km;
+  auto vel = 3.0_km / time;
+  auto y = x + 500.0_m;
+
+  out << "vel is float: " << std::is_same_v<decltype(vel)::ValueType, float> << "; should be 1" << std::endl;
+  out << "y is float: " << std::is_same_v<decltype(y)::ValueType, float> << "; should be 1" << std::endl;
+  out << "x = " << x.value() << " m; should be 2500 m" << std::endl;
+  out << "vel = " << vel.value() << " km/s; should be 0.75 km/s" << std::endl;
+  out << "y = " << y.value() << " m; should be 3000 m" << std::endl;
+  out << std::endl;
+}
+
 void useFunction(std::ostream& out)
 {
   out << "Testing passing parameters to function and getting result back:" << std::endl;
@@ -337,6 +974,23 @@ int main()
     MetaMeasure::Tests::literalCreation,
     MetaMeasure::Tests::copying,
     MetaMeasure::Tests::copyConversion,
+    MetaMeasure::Tests::conversionFactors,
+    MetaMeasure::Tests::integerConversion,
+    MetaMeasure::Tests::floatToIntegerConversion,
+    MetaMeasure::Tests::wideRatios,
+    MetaMeasure::Tests::batchConversion,
+    MetaMeasure::Tests::measurementArrays,
+    MetaMeasure::Tests::expressions,
+    MetaMeasure::Tests::measurementTables,
+    MetaMeasure::Tests::parsing,
+    MetaMeasure::Tests::formatting,
+    MetaMeasure::Tests::dynamicMeasurements,
+    MetaMeasure::Tests::binaryEncoding,
+    MetaMeasure::Tests::mappedFiles,
+    MetaMeasure::Tests::reductions,
+    MetaMeasure::Tests::compactStorage,
+    MetaMeasure::Tests::powersAndRoots,
+    MetaMeasure::Tests::measurementVectors,
     MetaMeasure::Tests::addition,
     MetaMeasure::Tests::subtraction,
     MetaMeasure::Tests::multiplication,
@@ -352,6 +1006,8 @@ int main()
     MetaMeasure::Tests::sameDimensionDivision,
     MetaMeasure::Tests::differentDimensionMultiplication,
     MetaMeasure::Tests::differentDimensionDivision,
+    MetaMeasure::Tests::unitOrdering,
+    MetaMeasure::Tests::adaptiveLiterals,
     MetaMeasure::Tests::useFunction
   };
 
@@ -0,0 +1,391 @@
+// Converts columns of a CSV or TSV file from one unit to another, streaming it so files of any size work
+//
+// Units are written like MetaMeasure/Parse.hpp reads them, so anything with a literal works, and so do products like m/s^2.
+// The factor between them comes from the ratios of the literals, which are worked out at compile time.
+// The file is read in large blocks on another thread while the last block is converted, and converted blocks are written
+// On another thread too. Each block is converted in 3 passes: numbers are read with std::from_chars, multiplied in one loop
+// The compiler can vectorize, then written with std::to_chars into a buffer that's reused for every block.
+// Fields aren't unquoted, so a quoted field with the delimiter in it splits in 2.
+//
+// Build it with optimizations:
+//   g++ -std=c++20 -O2 -pthread -Iinclude Tools/MetaMeasureConvert.cpp -o metameasure-convert
+//   ./metameasure-convert --col 3 --from ft --to m --header < readings.csv > readings_m.csv
+
+#include <MetaMeasure/Parse.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace MetaMeasure
+{
+
+namespace Tools
+{
+
+struct Options
+{
+  std::vector<std::size_t> columns;
+  std::string from;
+  std::string to;
+  char delimiter = ',';
+  bool header = false;
+  std::size_t blockSize = 16 << 20;
+  std::string input;
+  std::string output;
+};
+
+// The longest text std::to_chars writes for a double, with room to spare
+constexpr std::size_t MaxNumberLength = 32;
+
+// Works out how many of to's units 1 of from's units is, or prints why there isn't such a number
+bool conversionFactor(const std::string& from, const std::string& to, double& factor)
+{
+  Private::Parsing::ParsedUnit units[2];
+  const std::string* texts[2] = {&from, &to};
+
+  for (int i = 0; i < 2; ++i)
+  {
+    const char* first = texts[i]->data();
+    const char* last = first + texts[i]->size();
+    ParseResult result = Private::Parsing::parseUnit(first, last, units[i]);
+
+    if (result.error != ParseError::None || result.ptr != last)
+    {
+      std::cerr << "metameasure-convert: unknown unit '" << *texts[i] << "'" << std::endl;
+      return false;
+    }
+  }
+
+  for (std::size_t i = 0; i < DimensionCount; ++i)
+  {
+    if (units[0].exponents[i] != units[1].exponents[i])
+    {
+      std::cerr << "metameasure-convert: '" << from << "' and '" << to << "' don't measure the same thing" << std::endl;
+      return false;
+    }
+  }
+
+  factor = static_cast<double>(units[0].factor / units[1].factor);
+  return true;
+}
+
+// Converted text, in memory that's only allocated again when a block needs more than any block before it
+class OutputBuffer
+{
+public:
+  char* data() const { return this->text.get(); }
+  std::size_t size() const { return this->length; }
+  void clear() { this->length = 0; }
+
+  // Makes room for count more characters and gives back where they go, without initializing them
+  char* extend(std::size_t count)
+  {
+    if (this->length + count > this->capacity)
+    {
+      std::size_t capacity = std::max(this->length + count, this->capacity * 2);
+      std::unique_ptr<char[]> bigger(new char[capacity]);
+      std::copy(this->text.get(), this->text.get() + this->length, bigger.get());
+      this->text = std::move(bigger);
+      this->capacity = capacity;
+    }
+
+    return this->text.get() + this->length;
+  }
+
+  // Keeps the characters up to end, which was returned by extend()
+  void commit(const char* end)
+  {
+    this->length = static_cast<std::size_t>(end - this->text.get());
+  }
+
+private:
+  std::unique_ptr<char[]> text;
+  std::size_t length = 0;
+  std::size_t capacity = 0;
+};
+
+// Converts the chosen columns of whole lines, keeping everything else as it is
+class Converter
+{
+public:
+  Converter(const Options& options, double factor)
+    : delimiter(options.delimiter), skipLines(options.header ? 1 : 0), factor(factor)
+  {
+    for (std::size_t column : options.columns)
+    {
+      if (column > this->selected.size()) this->selected.resize(column, false);
+      this->selected[column - 1] = true;
+    }
+  }
+
+  // Converts the lines in [first, last) and appends them to out
+  // Gives back false after printing why if a field isn't a number.
+  bool convert(const char* first, const char* last, OutputBuffer& out)
+  {
+    this->fields.clear();
+    this->values.clear();
+
+    if (!this->readFields(first, last)) return false;
+
+    // Nothing in here but arithmetic on contiguous numbers, so this is the part that gets vectorized
+    double* values = this->values.data();
+    std::size_t count = this->values.size();
+    double factor = this->factor;
+    for (std::size_t i = 0; i < count; ++i) values[i] *= factor;
+
+    char* o = out.extend(static_cast<std::size_t>(last - first) + count * MaxNumberLength);
+    const char* cursor = first;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const Field& field = this->fields[i];
+      o = std::copy(cursor, field.first, o);
+      o = std::to_chars(o, o + MaxNumberLength, values[i]).ptr;
+      cursor = field.last;
+    }
+
+    out.commit(std::copy(cursor, last, o));
+    return true;
+  }
+
+private:
+  // Where a number to convert is in a block
+  struct Field
+  {
+    const char* first;
+    const char* last;
+  };
+
+  char delimiter;
+  std::size_t skipLines;
+  double factor;
+  std::vector<bool> selected;
+  std::size_t line = 0;
+
+  std::vector<Field> fields;
+  std::vector<double> values;
+
+  static bool isBlank(char c)
+  {
+    return c == ' ' || c == '\t';
+  }
+
+  bool readFields(const char* first, const char* last)
+  {
+    const char* p = first;
+
+    while (p != last)
+    {
+      const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+      const char* next = lineEnd == nullptr ? last : lineEnd + 1;
+      if (lineEnd == nullptr) lineEnd = last;
+      if (lineEnd != p && lineEnd[-1] == '\r') --lineEnd;
+
+      ++this->line;
+
+      if (this->line > this->skipLines && lineEnd != p)
+      {
+        std::size_t column = 0;
+        const char* fieldStart = p;
+
+        while (column < this->selected.size())
+        {
+          const char* fieldEnd = std::find(fieldStart, lineEnd, this->delimiter);
+          if (this->selected[column] && !this->readField(fieldStart, fieldEnd, column)) return false;
+          if (fieldEnd == lineEnd) break;
+
+          fieldStart = fieldEnd + 1;
+          ++column;
+        }
+      }
+
+      p = next;
+    }
+
+    return true;
+  }
+
+  // Reads the number in a field, if there is one; empty fields are left empty
+  bool readField(const char* first, const char* last, std::size_t column)
+  {
+    // The delimiter can be a tab, so blanks aren't trimmed when they're the delimiter
+    while (first != last && isBlank(*first) && *first != this->delimiter) ++first;
+    while (first != last && isBlank(last[-1]) && last[-1] != this->delimiter) --last;
+    if (first == last) return true;
+
+    const char* number = *first == '+' ? first + 1 : first;
+    double value;
+    std::from_chars_result result = std::from_chars(number, last, value);
+
+    if (result.ec != std::errc() || result.ptr != last)
+    {
+      std::cerr << "metameasure-convert: line " << this->line << ", column " << column + 1
+                << " isn't a number: '" << std::string_view(first, static_cast<std::size_t>(last - first)) << "'" << std::endl;
+      return false;
+    }
+
+    this->fields.push_back({first, last});
+    this->values.push_back(value);
+    return true;
+  }
+};
+
+// Reads and converts the input block by block, writing each converted block while the next one is read and converted
+bool run(const Options& options, double factor, std::FILE* in, std::FILE* out)
+{
+  Converter converter(options, factor);
+
+  std::unique_ptr<char[]> blocks[2] = {std::unique_ptr<char[]>(new char[options.blockSize]), std::unique_ptr<char[]>(new char[options.blockSize])};
+  OutputBuffer converted[2];
+
+  // A line that was cut off at the end of a block, which is finished at the start of the next one
+  std::vector<char> carry;
+
+  auto read = [in, &options](char* block)
+  {
+    return std::fread(block, 1, options.blockSize, in);
+  };
+
+  auto write = [out](const OutputBuffer& text)
+  {
+    return std::fwrite(text.data(), 1, text.size(), out) == text.size();
+  };
+
+  std::future<std::size_t> reading = std::async(std::launch::async, read, blocks[0].get());
+  std::future<bool> writing;
+  std::size_t current = 0;
+
+  while (true)
+  {
+    std::size_t size = reading.get();
+    bool end = size == 0;
+
+    if (!end)
+    {
+      reading = std::async(std::launch::async, read, blocks[current ^ 1].get());
+    }
+
+    const char* first = blocks[current].get();
+    const char* last = first + size;
+
+    // Both buffers of converted text take turns, so one is written while the other is filled
+    OutputBuffer& text = converted[current];
+    if (writing.valid() && !writing.get()) return false;
+    text.clear();
+
+    if (end)
+    {
+      // Whatever's left is the last line, which doesn't end with a newline
+      return converter.convert(carry.data(), carry.data() + carry.size(), text) &&
+             std::ferror(in) == 0 && write(text) && std::fflush(out) == 0;
+    }
+
+    const char* firstNewline = static_cast<const char*>(std::memchr(first, '\n', size));
+    const char* lastNewline = last;
+    while (lastNewline != first && lastNewline[-1] != '\n') --lastNewline;
+
+    if (firstNewline == nullptr)
+    {
+      carry.insert(carry.end(), first, last);
+      current ^= 1;
+      continue;
+    }
+
+    if (!carry.empty())
+    {
+      carry.insert(carry.end(), first, firstNewline + 1);
+      if (!converter.convert(carry.data(), carry.data() + carry.size(), text)) return false;
+      first = firstNewline + 1;
+    }
+
+    if (!converter.convert(first, lastNewline, text)) return false;
+    carry.assign(lastNewline, last);
+
+    writing = std::async(std::launch::async, write, std::cref(text));
+    current ^= 1;
+  }
+}
+
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  using namespace MetaMeasure::Tools;
+
+  Options options;
+  bool valid = true;
+
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    const char* option = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+    if (std::strcmp(option, "--header") == 0) options.header = true;
+    else if (std::strcmp(option, "--tsv") == 0) options.delimiter = '\t';
+    else if (value == nullptr) valid = false;
+    else
+    {
+      ++i;
+
+      if (std::strcmp(option, "--col") == 0)
+      {
+        long column = std::strtol(value, nullptr, 10);
+        if (column > 0) options.columns.push_back(static_cast<std::size_t>(column));
+        else valid = false;
+      }
+      else if (std::strcmp(option, "--from") == 0) options.from = value;
+      else if (std::strcmp(option, "--to") == 0) options.to = value;
+      else if (std::strcmp(option, "--delimiter") == 0 && std::strlen(value) == 1) options.delimiter = value[0];
+      else if (std::strcmp(option, "--block-size") == 0)
+      {
+        long megabytes = std::strtol(value, nullptr, 10);
+        if (megabytes > 0) options.blockSize = static_cast<std::size_t>(megabytes) << 20;
+        else valid = false;
+      }
+      else if (std::strcmp(option, "--input") == 0) options.input = value;
+      else if (std::strcmp(option, "--output") == 0) options.output = value;
+      else valid = false;
+    }
+  }
+
+  if (!valid || options.columns.empty() || options.from.empty() || options.to.empty())
+  {
+    std::cerr << "Usage: " << argv[0] << " --col N [--col N ...] --from unit --to unit [--header] [--tsv | --delimiter c]"
+              << " [--block-size MiB] [--input file] [--output file]" << std::endl;
+    return 1;
+  }
+
+  double factor;
+  if (!conversionFactor(options.from, options.to, factor)) return 1;
+
+  std::FILE* in = options.input.empty() ? stdin : std::fopen(options.input.c_str(), "rb");
+  std::FILE* out = options.output.empty() ? stdout : std::fopen(options.output.c_str(), "wb");
+
+  if (in == nullptr || out == nullptr)
+  {
+    std::cerr << "metameasure-convert: couldn't open " << (in == nullptr ? options.input : options.output) << std::endl;
+    return 1;
+  }
+
+  bool converted = run(options, factor, in, out);
+
+  if (in != stdin) std::fclose(in);
+  if (out != stdout && std::fclose(out) != 0) converted = false;
+
+  return converted ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+// The MetaMeasure named module
+// Exports everything MetaMeasure.hpp declares, so the unit catalogue is only parsed once per build
+// Macros can't be exported; include MetaMeasure/UnitMacros.hpp alongside the import if you need them.
+
+module;
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ratio>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+export module MetaMeasure;
+
+#define METAMEASURE_EXPORT export
+#include <MetaMeasure.hpp>
@@ -0,0 +1,349 @@
+#ifndef METAMEASURE_ARRAY_INCLUDED
+#define METAMEASURE_ARRAY_INCLUDED
+
+// Arrays of measurements that only keep the unit in the type
+// The values are stored as bare numbers, next to each other and aligned to a cache line,
+// And arithmetic on them builds expressions (see MetaMeasure/Expression.hpp), which are evaluated in a single loop.
+
+#include <MetaMeasure/Expression.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// The size of a cache line on pretty much everything MetaMeasure runs on
+inline constexpr std::size_t CacheLineSize = 64;
+
+// An allocator that aligns everything it allocates to Alignment bytes
+template<typename T, std::size_t Alignment = CacheLineSize>
+struct AlignedAllocator
+{
+  static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                "The alignment has to be a power of 2 that's at least the one T needs.");
+
+  using value_type = T;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  constexpr AlignedAllocator() = default;
+
+  template<typename U>
+  constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* p, std::size_t)
+  {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template<typename U>
+  constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const
+  {
+    return true;
+  }
+};
+
+template<typename NumT, DimensionVector DimensionsV, typename AllocatorT = AlignedAllocator<NumT>>
+class BasicMeasurementArray;
+
+// An array of measurements in the given units
+// Like Measurement, this lowers the units into a DimensionVector; use BasicMeasurementArray to pick an allocator.
+template<typename NumT, typename... Units>
+using MeasurementArray = BasicMeasurementArray<NumT, Private::dimensionsOf<Units...>()>;
+
+namespace Private
+{
+
+template<typename NumT, DimensionVector DimensionsV, typename AllocatorT>
+struct IsMeasurementArray<BasicMeasurementArray<NumT, DimensionsV, AllocatorT>> : std::true_type {};
+
+// How far apart the arrays an allocator gives out are known to be aligned
+template<typename AllocatorT>
+struct AlignmentOf : std::integral_constant<std::size_t, alignof(typename AllocatorT::value_type)> {};
+
+template<typename T, std::size_t Alignment>
+struct AlignmentOf<AlignedAllocator<T, Alignment>> : std::integral_constant<std::size_t, Alignment> {};
+
+// Converts every value, where out never overlaps in
+template<typename OutT, typename InT, typename Op>
+inline void mapValues(OutT* METAMEASURE_RESTRICT out, const InT* METAMEASURE_RESTRICT in, std::size_t n, Op op)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = op(in[i]);
+}
+
+}
+
+template<typename NumT, DimensionVector DimensionsV, typename AllocatorT>
+class BasicMeasurementArray
+{
+  static_assert(!DimensionsV.dimensionless(), "An array of dimensionless measurements is just a std::vector.");
+
+public:
+  using ValueType = NumT;
+  static constexpr DimensionVector Dimensions = DimensionsV;
+
+  // What a single element is read and written as
+  using Element = BasicMeasurement<NumT, DimensionsV>;
+  using AllocatorType = AllocatorT;
+
+private:
+  using ThisType = BasicMeasurementArray<NumT, DimensionsV, AllocatorT>;
+  using Storage = std::vector<NumT, AllocatorT>;
+
+  static constexpr std::size_t Alignment = Private::AlignmentOf<AllocatorT>::value;
+
+  // If the type is an array with the same dimensions, overloads that use this type may be called
+  template<typename A, typename T = int>
+  using IfConvertibleArray = std::enable_if_t
+  <
+    Private::IsMeasurementArray<A>::value && Private::IdenticalDimensions<ThisType, A>::value,
+    T
+  >;
+
+  // If the type is an expression of arrays with the same dimensions, overloads that use this type may be called
+  template<typename E, typename T = long>
+  using IfConvertibleExpression = std::enable_if_t
+  <
+    Private::IsMeasurementExpression<E>::value && Private::IdenticalDimensions<ThisType, E>::value,
+    T
+  >;
+
+  // If the measurements have the same dimensions, overloads that use this type may be called
+  template<typename M, typename T = short>
+  using IfConvertible = std::enable_if_t
+  <
+    Private::IsMeasurement<M>::value && Private::IdenticalDimensions<ThisType, M>::value,
+    T
+  >;
+
+  // A plain number, rather than a measurement of any sort
+  template<typename U, typename T = char>
+  using IfScalar = std::enable_if_t
+  <
+    Private::IsScalar<U>::value,
+    T
+  >;
+
+public:
+  // A single element of an array, which can be read and assigned like a measurement
+  class Reference
+  {
+  public:
+    constexpr operator Element() const { return Element(this->v); }
+    constexpr const ValueType& value() const { return this->v; }
+
+    constexpr Reference& operator=(const Reference& other)
+    {
+      this->v = other.v;
+      return *this;
+    }
+
+    template<typename M, IfConvertible<M> = 0>
+    constexpr Reference& operator=(const M& other)
+    {
+      this->v = Element(other).value();
+      return *this;
+    }
+
+    template<typename M, IfConvertible<M> = 0>
+    constexpr Reference& operator+=(const M& other)
+    {
+      this->v = (Element(this->v) + other).value();
+      return *this;
+    }
+
+    template<typename M, IfConvertible<M> = 0>
+    constexpr Reference& operator-=(const M& other)
+    {
+      this->v = (Element(this->v) - other).value();
+      return *this;
+    }
+
+  private:
+    friend class BasicMeasurementArray;
+
+    constexpr explicit Reference(ValueType& value) : v(value) {}
+
+    ValueType& v;
+  };
+
+  // Goes over the elements as measurements
+  class ConstIterator
+  {
+  public:
+    constexpr Element operator*() const { return Element(*this->p); }
+
+    constexpr ConstIterator& operator++()
+    {
+      ++this->p;
+      return *this;
+    }
+
+    constexpr bool operator==(const ConstIterator& other) const { return this->p == other.p; }
+    constexpr bool operator!=(const ConstIterator& other) const { return this->p != other.p; }
+
+  private:
+    friend class BasicMeasurementArray;
+
+    constexpr explicit ConstIterator(const ValueType* position) : p(position) {}
+
+    const ValueType* p;
+  };
+
+  BasicMeasurementArray() = default;
+
+  explicit BasicMeasurementArray(const AllocatorT& allocator)
+    : v(allocator)
+  {}
+
+  explicit BasicMeasurementArray(std::size_t size, const AllocatorT& allocator = AllocatorT())
+    : v(size, allocator)
+  {}
+
+  BasicMeasurementArray(std::size_t size, const Element& value, const AllocatorT& allocator = AllocatorT())
+    : v(size, value.value(), allocator)
+  {}
+
+  BasicMeasurementArray(std::initializer_list<Element> elements, const AllocatorT& allocator = AllocatorT())
+    : v(allocator)
+  {
+    this->v.reserve(elements.size());
+    for (const Element& element : elements) this->v.push_back(element.value());
+  }
+
+  // Converts an array with the same dimensions into this one's units
+  template<typename A, IfConvertibleArray<A> = 0>
+  BasicMeasurementArray(const A& other, const AllocatorT& allocator = AllocatorT())
+    : v(other.size(), allocator)
+  {
+    using OtherElement = typename A::Element;
+    Private::mapValues(this->data(), other.data(), other.size(),
+                       [](const typename A::ValueType& value) { return Element(OtherElement(value)).value(); });
+  }
+
+  // Evaluates an expression into a new array, converting it into this one's units
+  template<typename E, IfConvertibleExpression<E> = 0>
+  BasicMeasurementArray(const E& expression, const AllocatorT& allocator = AllocatorT())
+    : v(expression.size(), allocator)
+  {
+    expression.template evaluateInto<NumT, DimensionsV>(this->data());
+  }
+
+  std::size_t size() const { return this->v.size(); }
+  bool empty() const { return this->v.empty(); }
+  std::size_t capacity() const { return this->v.capacity(); }
+  AllocatorT allocator() const { return this->v.get_allocator(); }
+
+  void reserve(std::size_t capacity) { this->v.reserve(capacity); }
+  void resize(std::size_t size) { this->v.resize(size); }
+  void clear() { this->v.clear(); }
+
+  template<typename M, IfConvertible<M> = 0>
+  void push_back(const M& element)
+  {
+    this->v.push_back(Element(element).value());
+  }
+
+  Element operator[](std::size_t i) const { return Element(this->v[i]); }
+  Reference operator[](std::size_t i) { return Reference(this->v[i]); }
+
+  // The bare values, in this array's units
+  ValueType* data() { return std::assume_aligned<Alignment>(this->v.data()); }
+  const ValueType* data() const { return std::assume_aligned<Alignment>(this->v.data()); }
+
+  std::span<ValueType> values() { return std::span<ValueType>(this->data(), this->size()); }
+  std::span<const ValueType> values() const { return std::span<const ValueType>(this->data(), this->size()); }
+
+  ConstIterator begin() const { return ConstIterator(this->v.data()); }
+  ConstIterator end() const { return ConstIterator(this->v.data() + this->v.size()); }
+
+  // Arithmetic operators come from MetaMeasure/Expression.hpp
+
+  // Assignment operators
+  // Expressions are evaluated right into this array when it has the right size
+  template<typename E, IfConvertibleExpression<E> = 0>
+  ThisType& operator=(const E& expression)
+  {
+    if (expression.size() != this->size())
+    {
+      return *this = ThisType(expression, this->allocator());
+    }
+
+    expression.template evaluateInto<NumT, DimensionsV, true>(this->data());
+    return *this;
+  }
+
+  template<typename A, IfConvertibleArray<A> = 0>
+  ThisType& operator+=(const A& other)
+  {
+    return *this = *this + other;
+  }
+
+  template<typename A, IfConvertibleArray<A> = 0>
+  ThisType& operator-=(const A& other)
+  {
+    return *this = *this - other;
+  }
+
+  template<typename E, IfConvertibleExpression<E> = 0>
+  ThisType& operator+=(const E& other)
+  {
+    return *this = *this + other;
+  }
+
+  template<typename E, IfConvertibleExpression<E> = 0>
+  ThisType& operator-=(const E& other)
+  {
+    return *this = *this - other;
+  }
+
+  template<typename M, IfConvertible<M> = 0>
+  ThisType& operator+=(const M& other)
+  {
+    return *this = *this + other;
+  }
+
+  template<typename M, IfConvertible<M> = 0>
+  ThisType& operator-=(const M& other)
+  {
+    return *this = *this - other;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  ThisType& operator*=(const NumU& factor)
+  {
+    for (ValueType& value : this->v) value *= factor;
+    return *this;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  ThisType& operator/=(const NumU& divisor)
+  {
+    for (ValueType& value : this->v) value /= divisor;
+    return *this;
+  }
+
+private:
+  Storage v;
+};
+
+}
+
+#endif
@@ -0,0 +1,418 @@
+#ifndef METAMEASURE_BATCH_INCLUDED
+#define METAMEASURE_BATCH_INCLUDED
+
+// Converts whole spans of measurements at once
+// On x86, float, double and int32 conversions use SSE4.1, AVX2 or AVX-512 kernels, whichever the CPU has.
+// Everything else (and every other platform) uses plain loops, which the compiler is free to vectorize itself.
+
+#include <MetaMeasure/Measurement.hpp>
+#include <MetaMeasure/UnitMacros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define METAMEASURE_BATCH_X86
+#include <immintrin.h>
+#endif
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+namespace Private
+{
+
+namespace Batch
+{
+
+// The instruction sets there are kernels for, from worst to best
+enum class Isa
+{
+  Portable,
+  Sse41,
+  Avx2,
+  Avx512
+};
+
+inline Isa detectIsa()
+{
+#ifdef METAMEASURE_BATCH_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return Isa::Avx512;
+  if (__builtin_cpu_supports("avx2")) return Isa::Avx2;
+  if (__builtin_cpu_supports("sse4.1")) return Isa::Sse41;
+#endif
+  return Isa::Portable;
+}
+
+// The CPU is only asked once
+inline Isa bestIsa()
+{
+  static const Isa isa = detectIsa();
+  return isa;
+}
+
+template<typename T>
+inline void scalePortable(const T* in, T* out, std::size_t n, T factor)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * factor;
+}
+
+inline void intToFloatPortable(const std::int32_t* in, float* out, std::size_t n, float factor)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<float>(in[i]) * factor;
+}
+
+// Both limits are powers of 2, so they're exact as floats
+inline constexpr float Int32Lowest = -2147483648.f;
+inline constexpr float Int32PastHighest = 2147483648.f;
+
+// Narrows a rounded float into an int32_t the same way the kernels do
+// Unchecked gives the lowest int32_t for anything out of range (or NaN), which is what the x86 conversion instructions give,
+// So the tail of a kernel matches the rest of it instead of being undefined.
+template<typename OverflowT>
+inline std::int32_t narrowFloat(float x)
+{
+  if constexpr (std::is_same_v<OverflowT, Overflow::Unchecked>)
+  {
+    return x >= Int32Lowest && x < Int32PastHighest ? static_cast<std::int32_t>(x) : std::numeric_limits<std::int32_t>::lowest();
+  }
+  else
+  {
+    return Private::narrowRounded<std::int32_t, OverflowT>(x);
+  }
+}
+
+template<typename RoundingT, typename OverflowT>
+inline void floatToIntPortable(const float* in, std::int32_t* out, std::size_t n, float factor)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = Batch::narrowFloat<OverflowT>(Private::round<RoundingT>(in[i] * factor));
+}
+
+[[noreturn]] inline void throwOverflow()
+{
+  throw std::overflow_error("MetaMeasure: converted value doesn't fit in the value type");
+}
+
+#ifdef METAMEASURE_BATCH_X86
+
+// The rounding instructions are spelled differently for AVX-512
+#define _METAMEASURE_BATCH_ROUNDING(TARGET, VEC, P) \
+__attribute__((target(TARGET))) inline VEC truncate(VEC x) \
+{ return P##_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); } \
+__attribute__((target(TARGET))) inline VEC floor(VEC x) \
+{ return P##_round_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); } \
+METAMEASURE_FORCE_SEMICOLON
+
+// Stamps out the kernels for one instruction set
+// TARGET is what the functions get compiled for, P is the prefix of its intrinsics (_mm, _mm256, ...),
+// VEC, VECD and VECI are its float, double and integer vector types, and SI is the suffix of its integer loads.
+#define _METAMEASURE_BATCH_KERNELS(NAMESPACE, TARGET, VEC, VECD, VECI, P, SI) \
+namespace NAMESPACE \
+{ \
+constexpr std::size_t Floats = sizeof(VEC) / sizeof(float); \
+constexpr std::size_t Doubles = sizeof(VECD) / sizeof(double); \
+__attribute__((target(TARGET))) inline void scale(const float* in, float* out, std::size_t n, float factor) \
+{ \
+  const VEC f = P##_set1_ps(factor); \
+  std::size_t i = 0; \
+  for (; i + Floats <= n; i += Floats) P##_storeu_ps(out + i, P##_mul_ps(P##_loadu_ps(in + i), f)); \
+  Batch::scalePortable(in + i, out + i, n - i, factor); \
+} \
+__attribute__((target(TARGET))) inline void scale(const double* in, double* out, std::size_t n, double factor) \
+{ \
+  const VECD f = P##_set1_pd(factor); \
+  std::size_t i = 0; \
+  for (; i + Doubles <= n; i += Doubles) P##_storeu_pd(out + i, P##_mul_pd(P##_loadu_pd(in + i), f)); \
+  Batch::scalePortable(in + i, out + i, n - i, factor); \
+} \
+__attribute__((target(TARGET))) inline void intToFloat(const std::int32_t* in, float* out, std::size_t n, float factor) \
+{ \
+  const VEC f = P##_set1_ps(factor); \
+  std::size_t i = 0; \
+  for (; i + Floats <= n; i += Floats) \
+  { \
+    VECI v = P##_loadu_##SI(reinterpret_cast<const VECI*>(in + i)); \
+    P##_storeu_ps(out + i, P##_mul_ps(P##_cvtepi32_ps(v), f)); \
+  } \
+  Batch::intToFloatPortable(in + i, out + i, n - i, factor); \
+} \
+template<typename RoundingT, typename OverflowT> \
+__attribute__((target(TARGET))) inline void floatToInt(const float* in, std::int32_t* out, std::size_t n, float factor) \
+{ \
+  const VEC f = P##_set1_ps(factor); \
+  std::size_t i = 0; \
+  for (; i + Floats <= n; i += Floats) \
+  { \
+    VEC x = P##_mul_ps(P##_loadu_ps(in + i), f); \
+    if constexpr (std::is_same_v<RoundingT, Rounding::Floor>) \
+    { \
+      x = NAMESPACE::floor(x); \
+    } \
+    else if constexpr (std::is_same_v<RoundingT, Rounding::Nearest>) \
+    { \
+      VEC truncated = NAMESPACE::truncate(x); \
+      VEC cutOff = P##_sub_ps(x, truncated); \
+      x = P##_add_ps(truncated, NAMESPACE::truncate(P##_add_ps(cutOff, cutOff))); \
+    } \
+    if constexpr (std::is_same_v<OverflowT, Overflow::Checked>) \
+    { \
+      if (!NAMESPACE::fits(x)) Batch::throwOverflow(); \
+    } \
+    VECI converted = P##_cvttps_epi32(x); \
+    if constexpr (std::is_same_v<OverflowT, Overflow::Saturate>) \
+    { \
+      converted = NAMESPACE::saturate(x, converted); \
+    } \
+    P##_storeu_##SI(reinterpret_cast<VECI*>(out + i), converted); \
+  } \
+  Batch::floatToIntPortable<RoundingT, OverflowT>(in + i, out + i, n - i, factor); \
+} \
+} \
+METAMEASURE_FORCE_SEMICOLON
+
+// Every instruction set compares differently, so each has its own overflow checks
+// The conversion instructions give the lowest int32_t for anything out of range or NaN,
+// So saturate() only has to flip the lanes that were too big to the highest one and zero the NaNs, like narrowFloat does.
+namespace Sse41
+{
+
+_METAMEASURE_BATCH_ROUNDING("sse4.1", __m128, _mm);
+
+__attribute__((target("sse4.1"))) inline __m128i saturate(__m128 x, __m128i converted)
+{
+  __m128i big = _mm_castps_si128(_mm_cmpge_ps(x, _mm_set1_ps(Int32PastHighest)));
+  __m128i ordered = _mm_castps_si128(_mm_cmpord_ps(x, x));
+  return _mm_and_si128(_mm_xor_si128(converted, big), ordered);
+}
+
+__attribute__((target("sse4.1"))) inline bool fits(__m128 x)
+{
+  __m128 in = _mm_and_ps(_mm_cmpge_ps(x, _mm_set1_ps(Int32Lowest)), _mm_cmplt_ps(x, _mm_set1_ps(Int32PastHighest)));
+  return _mm_movemask_ps(in) == 0xF;
+}
+
+}
+
+namespace Avx2
+{
+
+_METAMEASURE_BATCH_ROUNDING("avx2", __m256, _mm256);
+
+__attribute__((target("avx2"))) inline __m256i saturate(__m256 x, __m256i converted)
+{
+  __m256i big = _mm256_castps_si256(_mm256_cmp_ps(x, _mm256_set1_ps(Int32PastHighest), _CMP_GE_OQ));
+  __m256i ordered = _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_ORD_Q));
+  return _mm256_and_si256(_mm256_xor_si256(converted, big), ordered);
+}
+
+__attribute__((target("avx2"))) inline bool fits(__m256 x)
+{
+  __m256 in = _mm256_and_ps(_mm256_cmp_ps(x, _mm256_set1_ps(Int32Lowest), _CMP_GE_OQ),
+                            _mm256_cmp_ps(x, _mm256_set1_ps(Int32PastHighest), _CMP_LT_OQ));
+  return _mm256_movemask_ps(in) == 0xFF;
+}
+
+}
+
+namespace Avx512
+{
+
+__attribute__((target("avx512f"))) inline __m512 truncate(__m512 x)
+{
+  return _mm512_roundscale_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+
+__attribute__((target("avx512f"))) inline __m512 floor(__m512 x)
+{
+  return _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+}
+
+__attribute__((target("avx512f"))) inline __m512i saturate(__m512 x, __m512i converted)
+{
+  __mmask16 big = _mm512_cmp_ps_mask(x, _mm512_set1_ps(Int32PastHighest), _CMP_GE_OQ);
+  __mmask16 ordered = _mm512_cmp_ps_mask(x, x, _CMP_ORD_Q);
+  converted = _mm512_mask_mov_epi32(converted, big, _mm512_set1_epi32(std::numeric_limits<std::int32_t>::max()));
+  return _mm512_maskz_mov_epi32(ordered, converted);
+}
+
+__attribute__((target("avx512f"))) inline bool fits(__m512 x)
+{
+  __mmask16 in = _mm512_cmp_ps_mask(x, _mm512_set1_ps(Int32Lowest), _CMP_GE_OQ) &
+                 _mm512_cmp_ps_mask(x, _mm512_set1_ps(Int32PastHighest), _CMP_LT_OQ);
+  return in == 0xFFFF;
+}
+
+}
+
+// GCC 12's AVX-512 header warns about its own placeholder values once the intrinsics are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+_METAMEASURE_BATCH_KERNELS(Sse41, "sse4.1", __m128, __m128d, __m128i, _mm, si128);
+_METAMEASURE_BATCH_KERNELS(Avx2, "avx2", __m256, __m256d, __m256i, _mm256, si256);
+_METAMEASURE_BATCH_KERNELS(Avx512, "avx512f", __m512, __m512d, __m512i, _mm512, si512);
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#undef _METAMEASURE_BATCH_ROUNDING
+#undef _METAMEASURE_BATCH_KERNELS
+
+// Calls the kernel for the best instruction set the CPU has
+// The call is variadic, so template arguments with commas can go through as they are.
+#define _METAMEASURE_BATCH_DISPATCH(...) \
+switch (Batch::bestIsa()) \
+{ \
+  case Isa::Avx512: Avx512::__VA_ARGS__; return; \
+  case Isa::Avx2: Avx2::__VA_ARGS__; return; \
+  case Isa::Sse41: Sse41::__VA_ARGS__; return; \
+  default: break; \
+}
+
+#else
+
+#define _METAMEASURE_BATCH_DISPATCH(...)
+
+#endif
+
+// Converts n values from FromT to ToT, scaling them by Ratio
+// in and out can be the same array
+template<typename ToT, Rational Ratio, typename RoundingT, typename OverflowT, typename FromT>
+inline void convertValues(const FromT* in, ToT* out, std::size_t n)
+{
+  constexpr bool SameType = std::is_same_v<ToT, FromT>;
+
+  if constexpr (SameType && (std::is_same_v<ToT, float> || std::is_same_v<ToT, double>))
+  {
+    if constexpr (Ratio == Rational())
+    {
+      if (static_cast<const void*>(in) != static_cast<const void*>(out))
+      {
+        for (std::size_t i = 0; i < n; ++i) out[i] = in[i];
+      }
+    }
+    else
+    {
+      _METAMEASURE_BATCH_DISPATCH(scale(in, out, n, ConversionFactor<ToT, Ratio>))
+      Batch::scalePortable(in, out, n, ConversionFactor<ToT, Ratio>);
+    }
+  }
+  else if constexpr (std::is_same_v<ToT, float> && std::is_same_v<FromT, std::int32_t>)
+  {
+    _METAMEASURE_BATCH_DISPATCH(intToFloat(in, out, n, ConversionFactor<float, Ratio>))
+    Batch::intToFloatPortable(in, out, n, ConversionFactor<float, Ratio>);
+  }
+  else if constexpr (std::is_same_v<ToT, std::int32_t> && std::is_same_v<FromT, float>)
+  {
+    _METAMEASURE_BATCH_DISPATCH(floatToInt<RoundingT, OverflowT>(in, out, n, ConversionFactor<float, Ratio>))
+    Batch::floatToIntPortable<RoundingT, OverflowT>(in, out, n, ConversionFactor<float, Ratio>);
+  }
+  else if constexpr (std::is_integral_v<ToT> && std::is_integral_v<FromT>)
+  {
+    for (std::size_t i = 0; i < n; ++i) out[i] = Private::scaleInteger<ToT, Ratio, RoundingT, OverflowT>(in[i]);
+  }
+  else if constexpr (std::is_integral_v<ToT>)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      out[i] = Private::narrowRounded<ToT, OverflowT>(Private::round<RoundingT>(in[i] * ConversionFactor<FromT, Ratio>));
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<ToT>(in[i]) * ConversionFactor<ToT, Ratio>;
+  }
+}
+
+#undef _METAMEASURE_BATCH_DISPATCH
+
+// A measurement is nothing but its value, so a span of them is also an array of values
+template<typename M>
+inline auto* valuesOf(M* measurements)
+{
+  using ValueType = std::conditional_t<std::is_const_v<M>, const typename M::ValueType, typename M::ValueType>;
+  static_assert(sizeof(M) == sizeof(ValueType) && std::is_standard_layout_v<M>,
+                "Measurements have to be laid out like their values to be converted in batches.");
+  return reinterpret_cast<ValueType*>(measurements);
+}
+
+}
+
+}
+
+// Converts every measurement in from into measurement To, and writes them to to
+// to has to be at least as long as from.
+// Integer values are converted to floating point before they're scaled,
+// And floating point values are scaled before they're rounded (see Rounding) into integers,
+// With OverflowT picking what happens to ones that don't fit (see Overflow), the same in every kernel.
+template<typename To, typename RoundingT = Rounding::Truncate, typename OverflowT = Overflow::Unchecked, typename From>
+void convert(std::span<const From> from, std::span<To> to)
+{
+  static_assert(Private::IdenticalDimensions<To, From>::value,
+                "Measurements can only be converted into measurements with the same dimensions.");
+
+  if (to.size() < from.size())
+  {
+    throw std::length_error("MetaMeasure: the span to convert into is shorter than the one to convert from");
+  }
+
+  constexpr Rational Ratio = Private::ConversionRatio<From::Dimensions, To::Dimensions>;
+  Private::Batch::convertValues<typename To::ValueType, Ratio, RoundingT, OverflowT>(Private::Batch::valuesOf(from.data()),
+                                                                                      Private::Batch::valuesOf(to.data()),
+                                                                                      from.size());
+}
+
+template<typename To, typename RoundingT = Rounding::Truncate, typename OverflowT = Overflow::Unchecked, typename From>
+void convert(std::span<From> from, std::span<To> to)
+{
+  MetaMeasure::convert<To, RoundingT, OverflowT>(std::span<const From>(from), to);
+}
+
+// Converts measurements where they are, and gives back the same memory as measurements of type To
+// To's value type has to be the same size as the one of From (like float and int32_t),
+// And the measurements in values shouldn't be used anymore afterwards.
+template<typename To, typename RoundingT = Rounding::Truncate, typename OverflowT = Overflow::Unchecked, typename From>
+std::span<To> convertInPlace(std::span<From> values)
+{
+  static_assert(Private::IdenticalDimensions<To, From>::value,
+                "Measurements can only be converted into measurements with the same dimensions.");
+  static_assert(sizeof(To) == sizeof(From) && alignof(To) <= alignof(From),
+                "Measurements can only be converted in place into measurements of the same size.");
+  static_assert(std::is_trivially_copyable_v<To> && std::is_trivially_copyable_v<From>,
+                "Only measurements that can be copied byte by byte can be converted in place.");
+
+  using ToT = typename To::ValueType;
+  constexpr Rational Ratio = Private::ConversionRatio<From::Dimensions, To::Dimensions>;
+
+  if (values.empty()) return {};
+
+  // The values are converted a chunk at a time into a buffer of ToT, then copied back over the ones they came from
+  // Copying the bytes is what makes them measurements of type To, so From and To are never read through each other's type.
+  constexpr std::size_t ChunkSize = 256;
+  ToT chunk[ChunkSize];
+  std::byte* storage = reinterpret_cast<std::byte*>(values.data());
+
+  for (std::size_t start = 0; start < values.size(); start += ChunkSize)
+  {
+    std::size_t count = values.size() - start < ChunkSize ? values.size() - start : ChunkSize;
+    Private::Batch::convertValues<ToT, Ratio, RoundingT, OverflowT>(Private::Batch::valuesOf(values.data() + start), chunk, count);
+    std::memcpy(storage + start * sizeof(To), chunk, count * sizeof(ToT));
+  }
+
+  return std::span<To>(std::launder(reinterpret_cast<To*>(storage)), values.size());
+}
+
+}
+
+#endif
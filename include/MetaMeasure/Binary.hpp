@@ -0,0 +1,376 @@
+#ifndef METAMEASURE_BINARY_INCLUDED
+#define METAMEASURE_BINARY_INCLUDED
+
+// A compact binary encoding for measurements, which keeps their units with them
+// Encoded measurements are a 32-byte header followed by the bare values, little-endian and back to back.
+// The header has a signature that's a hash of the measurement's dimension vector and value type, worked out at compile time,
+// So checking that data holds the measurements you expect is a single comparison.
+//
+// Header layout (every field is little-endian):
+//   0  "MMB1"
+//   4  value kind ('f' floating point, 'i' signed integer, 'u' unsigned integer)
+//   5  value size in bytes
+//   6  2 bytes set to 0
+//   8  signature (64 bits)
+//   16 number of values (64 bits)
+//   24 exponents of the 7 dimensions, 1 signed byte each in the order of DimensionOrder, and a byte set to 0
+
+#include <MetaMeasure/Batch.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// The size of the header encoded measurements start with
+// It's a multiple of every value type's alignment, so values read in place are aligned if the header is.
+inline constexpr std::size_t BinaryHeaderSize = 32;
+
+// What the header of encoded measurements says
+struct BinaryHeader
+{
+  char valueKind;
+  std::uint8_t valueSize;
+  std::uint64_t signature;
+  std::uint64_t count;
+  ExponentType exponents[DimensionCount];
+};
+
+namespace Private
+{
+
+namespace Binary
+{
+
+inline constexpr char Magic[4] = {'M', 'M', 'B', '1'};
+
+template<typename NumT>
+constexpr char valueKind()
+{
+  static_assert(std::is_arithmetic_v<NumT> && !std::is_same_v<NumT, bool>,
+                "Only measurements with integer or floating point values can be encoded.");
+  static_assert(!std::is_same_v<NumT, long double>,
+                "long double isn't laid out the same everywhere, so measurements that use it can't be encoded.");
+
+  if constexpr (std::is_floating_point_v<NumT>) return 'f';
+  else if constexpr (std::is_signed_v<NumT>) return 'i';
+  else return 'u';
+}
+
+// FNV-1a, fed 1 byte at a time
+constexpr std::uint64_t hashByte(std::uint64_t hash, std::uint8_t byte)
+{
+  return (hash ^ byte) * 0x100000001B3;
+}
+
+constexpr std::uint64_t hashInteger(std::uint64_t hash, WideInteger n)
+{
+  // The shift is split in 2 so it's also defined when WideInteger only has 64 bits
+  std::uint64_t halves[2] = {static_cast<std::uint64_t>(n), static_cast<std::uint64_t>((n >> 32) >> 32)};
+
+  for (std::uint64_t half : halves)
+  {
+    for (std::size_t i = 0; i < 8; ++i) hash = Binary::hashByte(hash, static_cast<std::uint8_t>(half >> (8 * i)));
+  }
+
+  return hash;
+}
+
+// Hashes everything that makes 2 measurement types different: the value type, and the dimension vector's
+// Exponents, units and overall ratio. Measurement types are aliases of their dimension vector, so the same
+// Units always give the same signature, whatever order they were written in.
+template<typename NumT, DimensionVector DimensionsV>
+consteval std::uint64_t signatureOf()
+{
+  std::uint64_t hash = 0xCBF29CE484222325;
+  hash = Binary::hashByte(hash, static_cast<std::uint8_t>(Binary::valueKind<NumT>()));
+  hash = Binary::hashByte(hash, sizeof(NumT));
+
+  for (std::size_t i = 0; i < DimensionCount; ++i)
+  {
+    hash = Binary::hashInteger(hash, DimensionsV.exponents[i]);
+    hash = Binary::hashInteger(hash, DimensionsV.scales[i].num);
+    hash = Binary::hashInteger(hash, DimensionsV.scales[i].den);
+  }
+
+  hash = Binary::hashInteger(hash, DimensionsV.ratio.num);
+  return Binary::hashInteger(hash, DimensionsV.ratio.den);
+}
+
+template<typename T>
+inline void storeLittle(std::byte* out, T value)
+{
+  if constexpr (std::endian::native == std::endian::little)
+  {
+    std::memcpy(out, &value, sizeof(T));
+  }
+  else
+  {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (std::size_t i = 0; i < sizeof(T); ++i) out[i] = static_cast<std::byte>(bytes[sizeof(T) - 1 - i]);
+  }
+}
+
+template<typename T>
+inline T loadLittle(const std::byte* in)
+{
+  T value;
+
+  if constexpr (std::endian::native == std::endian::little)
+  {
+    std::memcpy(&value, in, sizeof(T));
+  }
+  else
+  {
+    unsigned char bytes[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i) bytes[i] = static_cast<unsigned char>(in[sizeof(T) - 1 - i]);
+    std::memcpy(&value, bytes, sizeof(T));
+  }
+
+  return value;
+}
+
+// Checks the header and that the values it announces are all there
+inline BinaryHeader readHeader(std::span<const std::byte> in)
+{
+  if (in.size() < BinaryHeaderSize || std::memcmp(in.data(), Binary::Magic, sizeof(Binary::Magic)) != 0)
+  {
+    throw std::invalid_argument("MetaMeasure: the data doesn't start with a header of encoded measurements");
+  }
+
+  BinaryHeader header;
+  header.valueKind = static_cast<char>(in[4]);
+  header.valueSize = static_cast<std::uint8_t>(in[5]);
+  header.signature = Binary::loadLittle<std::uint64_t>(in.data() + 8);
+  header.count = Binary::loadLittle<std::uint64_t>(in.data() + 16);
+
+  for (std::size_t i = 0; i < DimensionCount; ++i)
+  {
+    header.exponents[i] = static_cast<std::int8_t>(in[24 + i]);
+  }
+
+  if (header.valueSize == 0 || header.count > (in.size() - BinaryHeaderSize) / header.valueSize)
+  {
+    throw std::invalid_argument("MetaMeasure: the data is shorter than its header says");
+  }
+
+  return header;
+}
+
+// Whether the header announces values of type NumT in the units of DimensionsV
+// The value kind and size are checked along with the signature, so a header can't pass for another type's.
+template<typename NumT, DimensionVector DimensionsV>
+constexpr bool isHeaderOf(const BinaryHeader& header)
+{
+  return header.signature == Binary::signatureOf<NumT, DimensionsV>() &&
+         header.valueKind == Binary::valueKind<NumT>() && header.valueSize == sizeof(NumT);
+}
+
+// Checks that all the values the header announces fit in the body, as values of type NumT
+// The value size in the header isn't trusted for this, so the values read are never past the end of in.
+template<typename NumT>
+inline void checkBodyOf(const BinaryHeader& header, std::span<const std::byte> in)
+{
+  if (header.count > (in.size() - BinaryHeaderSize) / sizeof(NumT))
+  {
+    throw std::invalid_argument("MetaMeasure: the data is shorter than its header says");
+  }
+}
+
+// Converts the values of From in in into out, a chunk at a time when they can't be read in place
+template<typename To, typename From, typename RoundingT>
+inline void decodeValues(const std::byte* in, To* out, std::size_t n)
+{
+  using FromT = typename From::ValueType;
+  using ToT = typename To::ValueType;
+
+  constexpr Rational Ratio = Private::ConversionRatio<From::Dimensions, To::Dimensions>;
+
+  if (std::endian::native == std::endian::little && reinterpret_cast<std::uintptr_t>(in) % alignof(FromT) == 0)
+  {
+    Private::Batch::convertValues<ToT, Ratio, RoundingT, Overflow::Unchecked>(reinterpret_cast<const FromT*>(in),
+                                                                              Private::Batch::valuesOf(out), n);
+    return;
+  }
+
+  constexpr std::size_t ChunkSize = 256;
+  FromT chunk[ChunkSize];
+
+  for (std::size_t start = 0; start < n; start += ChunkSize)
+  {
+    std::size_t count = n - start < ChunkSize ? n - start : ChunkSize;
+    for (std::size_t i = 0; i < count; ++i) chunk[i] = Binary::loadLittle<FromT>(in + (start + i) * sizeof(FromT));
+    Private::Batch::convertValues<ToT, Ratio, RoundingT, Overflow::Unchecked>(chunk, Private::Batch::valuesOf(out + start), count);
+  }
+}
+
+// Tries each type in From... until one has the signature in the header
+template<typename To, typename RoundingT>
+inline bool decodeAny(const BinaryHeader&, std::span<const std::byte>, To*)
+{
+  return false;
+}
+
+template<typename To, typename RoundingT, typename From, typename... Rest>
+inline bool decodeAny(const BinaryHeader& header, std::span<const std::byte> in, To* out)
+{
+  static_assert(Private::IdenticalDimensions<To, From>::value,
+                "Measurements can only be decoded into measurements with the same dimensions.");
+
+  using FromT = typename From::ValueType;
+  constexpr DimensionVector FromDimensions = From::Dimensions;
+
+  if (!Binary::isHeaderOf<FromT, FromDimensions>(header))
+  {
+    return Binary::decodeAny<To, RoundingT, Rest...>(header, in, out);
+  }
+
+  Binary::checkBodyOf<FromT>(header, in);
+  Binary::decodeValues<To, From, RoundingT>(in.data() + BinaryHeaderSize, out, header.count);
+  return true;
+}
+
+}
+
+}
+
+// The signature in the header of encoded measurements of type M
+template<typename M>
+inline constexpr std::uint64_t BinarySignature = Private::Binary::signatureOf<typename M::ValueType, M::Dimensions>();
+
+// How many bytes count measurements of type M take once they're encoded
+template<typename M>
+constexpr std::size_t encodedSize(std::size_t count)
+{
+  return BinaryHeaderSize + count * sizeof(typename M::ValueType);
+}
+
+// Encodes measurements into out, and gives back how many bytes were written
+// Throws a std::length_error if out is shorter than encodedSize<M>(values.size()).
+template<typename M>
+std::size_t encode(std::span<const M> values, std::span<std::byte> out)
+{
+  static_assert(Private::IsMeasurement<M>::value, "Only measurements can be encoded.");
+
+  using ValueType = typename M::ValueType;
+  constexpr DimensionVector Dimensions = M::Dimensions;
+
+  std::size_t size = MetaMeasure::encodedSize<M>(values.size());
+
+  if (out.size() < size)
+  {
+    throw std::length_error("MetaMeasure: the buffer to encode into is too short");
+  }
+
+  std::byte* header = out.data();
+  std::memset(header, 0, BinaryHeaderSize);
+  std::memcpy(header, Private::Binary::Magic, sizeof(Private::Binary::Magic));
+  header[4] = static_cast<std::byte>(Private::Binary::valueKind<ValueType>());
+  header[5] = static_cast<std::byte>(sizeof(ValueType));
+  Private::Binary::storeLittle<std::uint64_t>(header + 8, BinarySignature<M>);
+  Private::Binary::storeLittle<std::uint64_t>(header + 16, values.size());
+
+  for (std::size_t i = 0; i < DimensionCount; ++i)
+  {
+    header[24 + i] = static_cast<std::byte>(static_cast<std::int8_t>(Dimensions.exponents[i]));
+  }
+
+  const ValueType* in = Private::Batch::valuesOf(values.data());
+  std::byte* body = out.data() + BinaryHeaderSize;
+
+  if constexpr (std::endian::native == std::endian::little)
+  {
+    if (!values.empty()) std::memcpy(body, in, values.size() * sizeof(ValueType));
+  }
+  else
+  {
+    for (std::size_t i = 0; i < values.size(); ++i) Private::Binary::storeLittle(body + i * sizeof(ValueType), in[i]);
+  }
+
+  return size;
+}
+
+template<typename M>
+std::size_t encode(std::span<M> values, std::span<std::byte> out)
+{
+  return MetaMeasure::encode(std::span<const M>(values), out);
+}
+
+template<typename M>
+std::size_t encode(const M& value, std::span<std::byte> out)
+{
+  return MetaMeasure::encode(std::span<const M>(&value, 1), out);
+}
+
+// Reads the header of encoded measurements
+// Throws a std::invalid_argument if in doesn't start with one, or is too short for the values it announces.
+inline BinaryHeader readBinaryHeader(std::span<const std::byte> in)
+{
+  return Private::Binary::readHeader(in);
+}
+
+// Gives back encoded measurements of type M where they are, without copying them
+// Throws a std::invalid_argument if they aren't measurements of type M (which is checked from the signature, value kind and size),
+// If the data is too short for as many Ms as the header announces, or if they can't be read in place because they aren't aligned for M.
+template<typename M>
+std::span<const M> view(std::span<const std::byte> in)
+{
+  static_assert(std::endian::native == std::endian::little,
+                "Encoded measurements are little-endian, so they can only be read in place on little-endian machines.");
+
+  using ValueType = typename M::ValueType;
+  constexpr DimensionVector Dimensions = M::Dimensions;
+
+  BinaryHeader header = Private::Binary::readHeader(in);
+
+  if (!Private::Binary::isHeaderOf<ValueType, Dimensions>(header))
+  {
+    throw std::invalid_argument("MetaMeasure: the encoded measurements aren't of the type they're viewed as");
+  }
+
+  Private::Binary::checkBodyOf<ValueType>(header, in);
+  const std::byte* body = in.data() + BinaryHeaderSize;
+
+  if (reinterpret_cast<std::uintptr_t>(body) % alignof(M) != 0)
+  {
+    throw std::invalid_argument("MetaMeasure: the encoded measurements aren't aligned for their type");
+  }
+
+  return std::span<const M>(reinterpret_cast<const M*>(body), header.count);
+}
+
+// Decodes measurements into out, converting them on the way if they were encoded as one of From...
+// The measurements are copied if they're already of type To; otherwise each type in From... is checked in order,
+// And the first one with the right signature is converted with a batch conversion (see MetaMeasure/Batch.hpp).
+// Gives back how many measurements were decoded, and throws a std::invalid_argument if none of the types match,
+// Or a std::length_error if out is too short.
+template<typename To, typename... From>
+std::size_t decode(std::span<const std::byte> in, std::span<To> out)
+{
+  static_assert(Private::IsMeasurement<To>::value, "Only measurements can be decoded.");
+
+  BinaryHeader header = Private::Binary::readHeader(in);
+
+  if (out.size() < header.count)
+  {
+    throw std::length_error("MetaMeasure: the span to decode into is shorter than the encoded measurements");
+  }
+
+  if (!Private::Binary::decodeAny<To, Rounding::Truncate, To, From...>(header, in, out.data()))
+  {
+    throw std::invalid_argument("MetaMeasure: the encoded measurements aren't of any of the types they can be decoded from");
+  }
+
+  return header.count;
+}
+
+}
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef METAMEASURE_COMPACT_INCLUDED
+#define METAMEASURE_COMPACT_INCLUDED
+
+// Measurements stored in a smaller type than they're computed in, like millimeters stored as int16 ticks
+// Compact<M, StorageT> holds a StorageT in M's units, and widens into M for any arithmetic.
+// The units pick the resolution: Compact<Millimeters<float>, std::int16_t> holds whole millimeters,
+// And converting it into anything else (like meters) is a multiplication by a ratio worked out at compile time.
+// widen() and narrow() convert whole spans at once, folding the unit conversion into the same loop.
+
+#include <MetaMeasure/Measurement.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// An IEEE 754 half precision (binary16) number, which is only for storage
+// It converts to and from float, rounding to the nearest half, and does no arithmetic of its own.
+// The conversions are plain bit operations rather than _Float16, which isn't standard C++ and only some compilers and targets have,
+// So Half works the same everywhere; where _Float16 does exist, the two give the same bits.
+class Half
+{
+public:
+  constexpr Half() = default;
+  constexpr explicit Half(float value) : b(Half::fromFloat(value)) {}
+
+  constexpr operator float() const { return Half::toFloat(this->b); }
+
+  static constexpr Half fromBits(std::uint16_t bits)
+  {
+    Half half;
+    half.b = bits;
+    return half;
+  }
+
+  constexpr std::uint16_t bits() const { return this->b; }
+
+private:
+  std::uint16_t b = 0;
+
+  static constexpr std::uint16_t fromFloat(float value)
+  {
+    std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+    std::uint32_t sign = (x >> 16) & 0x8000;
+    std::uint32_t magnitude = x & 0x7FFFFFFF;
+
+    // Infinity, and NaN (kept quiet)
+    if (magnitude >= 0x7F800000) return static_cast<std::uint16_t>(sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0));
+
+    // 65520 and up round to infinity
+    if (magnitude >= 0x477FF000) return static_cast<std::uint16_t>(sign | 0x7C00);
+
+    // Below 2^-14 the result is subnormal, and adding 0.5 makes the float hardware round it at the right bit
+    if (magnitude < 0x38800000)
+    {
+      float shifted = std::bit_cast<float>(magnitude) + 0.5f;
+      return static_cast<std::uint16_t>(sign | (std::bit_cast<std::uint32_t>(shifted) - 0x3F000000));
+    }
+
+    // Rebiases the exponent and rounds the mantissa to nearest, with ties to even
+    magnitude += 0xC8000FFF + ((magnitude >> 13) & 1);
+    return static_cast<std::uint16_t>(sign | (magnitude >> 13));
+  }
+
+  static constexpr float toFloat(std::uint16_t bits)
+  {
+    std::uint32_t sign = static_cast<std::uint32_t>(bits & 0x8000) << 16;
+    std::uint32_t exponent = (bits >> 10) & 0x1F;
+    std::uint32_t mantissa = bits & 0x3FF;
+
+    if (exponent == 0)
+    {
+      // Subnormals are the mantissa times 2^-24, which float holds exactly
+      float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+      return std::bit_cast<float>(sign | std::bit_cast<std::uint32_t>(magnitude));
+    }
+
+    if (exponent == 0x1F) return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+  }
+};
+
+// A bfloat16 number (the top half of a float), which is only for storage
+// It has float's range with 8 bits of precision, converts to and from float, rounding to nearest, and does no arithmetic of its own.
+class BFloat16
+{
+public:
+  constexpr BFloat16() = default;
+  constexpr explicit BFloat16(float value) : b(BFloat16::fromFloat(value)) {}
+
+  constexpr operator float() const { return std::bit_cast<float>(static_cast<std::uint32_t>(this->b) << 16); }
+
+  static constexpr BFloat16 fromBits(std::uint16_t bits)
+  {
+    BFloat16 number;
+    number.b = bits;
+    return number;
+  }
+
+  constexpr std::uint16_t bits() const { return this->b; }
+
+private:
+  std::uint16_t b = 0;
+
+  static constexpr std::uint16_t fromFloat(float value)
+  {
+    std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+
+    // NaN has to stay NaN, so it can't be rounded into infinity
+    if ((x & 0x7FFFFFFF) > 0x7F800000) return static_cast<std::uint16_t>((x >> 16) | 0x40);
+
+    // Rounds to nearest, with ties to even
+    return static_cast<std::uint16_t>((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+  }
+};
+
+namespace Private
+{
+
+namespace Storage
+{
+
+template<typename StorageT>
+inline constexpr bool IsFloat16 = std::is_same_v<StorageT, Half> || std::is_same_v<StorageT, BFloat16>;
+
+// Widens a stored value into the compute type
+template<typename ComputeT, typename StorageT>
+constexpr ComputeT widen(const StorageT& stored)
+{
+  if constexpr (IsFloat16<StorageT>)
+  {
+    return static_cast<ComputeT>(static_cast<float>(stored));
+  }
+  else
+  {
+    return static_cast<ComputeT>(stored);
+  }
+}
+
+// Narrows a computed value into the storage type
+// Integers are rounded with RoundingT and clamped to the storage type's range, and NaN is stored as 0.
+template<typename StorageT, typename RoundingT, typename ComputeT>
+constexpr StorageT narrow(const ComputeT& value)
+{
+  if constexpr (IsFloat16<StorageT>)
+  {
+    return StorageT(static_cast<float>(value));
+  }
+  else if constexpr (std::is_integral_v<StorageT> && std::is_floating_point_v<ComputeT>)
+  {
+    constexpr ComputeT Lowest = static_cast<ComputeT>(std::numeric_limits<StorageT>::min());
+    constexpr ComputeT Highest = static_cast<ComputeT>(std::numeric_limits<StorageT>::max());
+
+    ComputeT rounded = Private::round<RoundingT>(value);
+    if (rounded >= Highest) return std::numeric_limits<StorageT>::max();
+    if (rounded <= Lowest) return std::numeric_limits<StorageT>::min();
+    if (!(rounded == rounded)) return 0;
+    return static_cast<StorageT>(rounded);
+  }
+  else if constexpr (std::is_integral_v<StorageT>)
+  {
+    // Compared as integers, so the limits aren't cut down when the types have different signs or StorageT is wider
+    if (std::cmp_greater(value, std::numeric_limits<StorageT>::max())) return std::numeric_limits<StorageT>::max();
+    if (std::cmp_less(value, std::numeric_limits<StorageT>::min())) return std::numeric_limits<StorageT>::min();
+    return static_cast<StorageT>(value);
+  }
+  else
+  {
+    return static_cast<StorageT>(value);
+  }
+}
+
+// Compact measurements widened into what they measure, and anything else as it is
+template<typename T>
+constexpr auto widened(const T& value)
+{
+  if constexpr (IsCompactMeasurement<T>::value) return value.widen();
+  else return value;
+}
+
+}
+
+}
+
+// A measurement M stored as a StorageT in M's units, which widens into M for arithmetic
+// StorageT can be a smaller integer (int16_t, int8_t), Half, BFloat16, or any type M's value type converts to and from.
+// Storing a value that doesn't fit clamps it to the storage type's range, rounding it with RoundingT if it's an integer.
+template<typename M, typename StorageT, typename RoundingT = Rounding::Nearest>
+class Compact
+{
+  static_assert(Private::IsMeasurement<M>::value, "Compact measurements have to widen into a measurement.");
+
+  using ThisType = Compact<M, StorageT, RoundingT>;
+  using ComputeType = typename M::ValueType;
+
+  // If the type is a measurement or another compact measurement, overloads that use this type may be called
+  template<typename T, typename U = int>
+  using IfMeasurement = std::enable_if_t<Private::IsMeasurement<T>::value || Private::IsCompactMeasurement<T>::value, U>;
+
+  // If the type is a plain number, overloads that use this type may be called
+  template<typename T, typename U = char>
+  using IfScalar = std::enable_if_t<Private::IsScalar<T>::value, U>;
+
+public:
+  using Measurement = M;
+  using StorageType = StorageT;
+  using ValueType = ComputeType;
+
+  constexpr Compact() = default;
+
+  constexpr Compact(const M& measurement)
+    : s(Private::Storage::narrow<StorageT, RoundingT>(measurement.value()))
+  {}
+
+  // Converts any measurement with M's dimensions into M's units first
+  template<typename M2, std::enable_if_t<Private::IsMeasurement<M2>::value && !std::is_same_v<M2, M>, int> = 0>
+  constexpr Compact(const M2& measurement)
+    : Compact(M(measurement))
+  {}
+
+  static constexpr ThisType fromStored(StorageT stored)
+  {
+    ThisType compact;
+    compact.s = stored;
+    return compact;
+  }
+
+  constexpr const StorageT& stored() const { return this->s; }
+  constexpr ComputeType value() const { return Private::Storage::widen<ComputeType>(this->s); }
+  constexpr M widen() const { return M(this->value()); }
+
+  constexpr operator M() const { return this->widen(); }
+
+  // Anything but M itself is reached through M, so every conversion M has works here too
+  template<typename M2, std::enable_if_t<Private::IsMeasurement<M2>::value && !std::is_same_v<M2, M>, int> = 0>
+  constexpr explicit operator M2() const { return M2(this->widen()); }
+
+  // Arithmetic and comparisons widen both sides and give back what M's operators do
+#define _METAMEASURE_COMPACT_OPERATOR(OP) \
+  template<typename R, IfMeasurement<R> = 0> \
+  friend constexpr auto operator OP(const ThisType& l, const R& r) \
+  { \
+    return l.widen() OP Private::Storage::widened(r); \
+  } \
+  template<typename L, std::enable_if_t<Private::IsMeasurement<L>::value, int> = 0> \
+  friend constexpr auto operator OP(const L& l, const ThisType& r) \
+  { \
+    return l OP r.widen(); \
+  }
+
+  _METAMEASURE_COMPACT_OPERATOR(+)
+  _METAMEASURE_COMPACT_OPERATOR(-)
+  _METAMEASURE_COMPACT_OPERATOR(*)
+  _METAMEASURE_COMPACT_OPERATOR(/)
+  _METAMEASURE_COMPACT_OPERATOR(==)
+  _METAMEASURE_COMPACT_OPERATOR(!=)
+  _METAMEASURE_COMPACT_OPERATOR(<)
+  _METAMEASURE_COMPACT_OPERATOR(<=)
+  _METAMEASURE_COMPACT_OPERATOR(>)
+  _METAMEASURE_COMPACT_OPERATOR(>=)
+
+#undef _METAMEASURE_COMPACT_OPERATOR
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr M operator*(const ThisType& l, const NumU& r)
+  {
+    return l.widen() * r;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr M operator*(const NumU& l, const ThisType& r)
+  {
+    return l * r.widen();
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr M operator/(const ThisType& l, const NumU& r)
+  {
+    return l.widen() / r;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr auto operator/(const NumU& l, const ThisType& r)
+  {
+    return l / r.widen();
+  }
+
+  friend constexpr M operator-(const ThisType& m)
+  {
+    return -m.widen();
+  }
+
+  // Assignment operators, which narrow the result back into storage
+  template<typename R, IfMeasurement<R> = 0>
+  constexpr ThisType& operator+=(const R& other) { return *this = ThisType(*this + other); }
+
+  template<typename R, IfMeasurement<R> = 0>
+  constexpr ThisType& operator-=(const R& other) { return *this = ThisType(*this - other); }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType& operator*=(const NumU& factor) { return *this = ThisType(*this * factor); }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType& operator/=(const NumU& divisor) { return *this = ThisType(*this / divisor); }
+
+private:
+  StorageT s = {};
+};
+
+namespace Private
+{
+
+template<typename M, typename StorageT, typename RoundingT>
+struct IsCompactMeasurement<Compact<M, StorageT, RoundingT>> : std::true_type {};
+
+}
+
+// Widens every compact measurement in from into measurement To, and writes them to to
+// The conversion from M's units into To's is folded into the same multiplication, so it's 1 pass the compiler can vectorize.
+// to has to be at least as long as from.
+template<typename To, typename M, typename StorageT, typename RoundingT>
+void widen(std::span<const Compact<M, StorageT, RoundingT>> from, std::span<To> to)
+{
+  static_assert(Private::IdenticalDimensions<To, M>::value,
+                "Compact measurements can only be widened into measurements with the same dimensions.");
+
+  if (to.size() < from.size())
+  {
+    throw std::length_error("MetaMeasure: the span to widen into is shorter than the one to widen from");
+  }
+
+  using ToT = typename To::ValueType;
+  constexpr DimensionVector FromDimensions = M::Dimensions;
+  constexpr DimensionVector ToDimensions = To::Dimensions;
+  constexpr Rational Ratio = Private::ConversionRatio<FromDimensions, ToDimensions>;
+
+  const Compact<M, StorageT, RoundingT>* in = from.data();
+  To* out = to.data();
+
+  if constexpr (std::is_floating_point_v<ToT>)
+  {
+    constexpr ToT Factor = Private::ConversionFactor<ToT, Ratio>;
+    for (std::size_t i = 0; i < from.size(); ++i) out[i] = To(Private::Storage::widen<ToT>(in[i].stored()) * Factor);
+  }
+  else
+  {
+    for (std::size_t i = 0; i < from.size(); ++i) out[i] = To(in[i].widen());
+  }
+}
+
+template<typename To, typename M, typename StorageT, typename RoundingT>
+void widen(std::span<Compact<M, StorageT, RoundingT>> from, std::span<To> to)
+{
+  MetaMeasure::widen(std::span<const Compact<M, StorageT, RoundingT>>(from), to);
+}
+
+// Narrows every measurement in from into a compact measurement, and writes them to to
+// Values are converted into M's units first, in the same pass.
+// to has to be at least as long as from.
+template<typename From, typename M, typename StorageT, typename RoundingT>
+void narrow(std::span<const From> from, std::span<Compact<M, StorageT, RoundingT>> to)
+{
+  static_assert(Private::IdenticalDimensions<From, M>::value,
+                "Measurements can only be narrowed into compact measurements with the same dimensions.");
+
+  if (to.size() < from.size())
+  {
+    throw std::length_error("MetaMeasure: the span to narrow into is shorter than the one to narrow from");
+  }
+
+  using ComputeT = typename M::ValueType;
+  using ToType = Compact<M, StorageT, RoundingT>;
+  constexpr DimensionVector FromDimensions = From::Dimensions;
+  constexpr DimensionVector ToDimensions = M::Dimensions;
+  constexpr Rational Ratio = Private::ConversionRatio<FromDimensions, ToDimensions>;
+
+  const From* in = from.data();
+  ToType* out = to.data();
+
+  if constexpr (std::is_floating_point_v<ComputeT>)
+  {
+    constexpr ComputeT Factor = Private::ConversionFactor<ComputeT, Ratio>;
+
+    for (std::size_t i = 0; i < from.size(); ++i)
+    {
+      out[i] = ToType::fromStored(Private::Storage::narrow<StorageT, RoundingT>(static_cast<ComputeT>(in[i].value()) * Factor));
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < from.size(); ++i) out[i] = ToType(M(in[i]));
+  }
+}
+
+template<typename From, typename M, typename StorageT, typename RoundingT>
+void narrow(std::span<From> from, std::span<Compact<M, StorageT, RoundingT>> to)
+{
+  MetaMeasure::narrow(std::span<const From>(from), to);
+}
+
+}
+
+#endif
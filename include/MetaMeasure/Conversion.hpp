@@ -0,0 +1,249 @@
+#ifndef METAMEASURE_CONVERSION_INCLUDED
+#define METAMEASURE_CONVERSION_INCLUDED
+
+#include <MetaMeasure/Utility.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// How a conversion between integer measurements rounds when the result isn't a whole number
+namespace Rounding
+{
+
+// Rounds toward zero, like integer division does
+struct Truncate {};
+
+// Rounds to the nearest whole number, with halves rounded away from zero
+struct Nearest {};
+
+// Rounds toward negative infinity
+struct Floor {};
+
+}
+
+// What a conversion between integer measurements does when the result doesn't fit in the value type
+namespace Overflow
+{
+
+// The result is cut down to the value type like a static_cast would
+struct Unchecked {};
+
+// The result is clamped to the smallest or largest value the value type can hold
+struct Saturate {};
+
+// A std::overflow_error is thrown (or the constant expression fails to compile)
+struct Checked {};
+
+}
+
+namespace Private
+{
+
+// Checks if a * b fits in an intmax_t, for positive a and b
+constexpr bool productFits(WideInteger a, WideInteger b)
+{
+  return a <= std::numeric_limits<std::intmax_t>::max() / b;
+}
+
+// Rounds a quotient by its remainder
+// The divisor has to be positive; the remainder has the dividend's sign, like the % operator gives.
+template<typename RoundingT>
+constexpr WideInteger roundQuotient(WideInteger result, WideInteger remainder, WideInteger divisor)
+{
+  if constexpr (std::is_same_v<RoundingT, Rounding::Floor>)
+  {
+    result -= (remainder < 0);
+  }
+  else if constexpr (std::is_same_v<RoundingT, Rounding::Nearest>)
+  {
+    result += (2 * remainder >= divisor) - (2 * remainder <= -divisor);
+  }
+  else
+  {
+    static_assert(std::is_same_v<RoundingT, Rounding::Truncate>, "Unknown rounding mode.");
+  }
+
+  return result;
+}
+
+// Rounds a quotient by its remainder, then narrows it into a To with an overflow policy
+template<typename To, typename RoundingT, typename OverflowT>
+constexpr To narrowQuotient(WideInteger result, WideInteger remainder, WideInteger divisor)
+{
+  result = Private::roundQuotient<RoundingT>(result, remainder, divisor);
+
+  constexpr WideInteger Lowest = static_cast<WideInteger>(std::numeric_limits<To>::lowest());
+  constexpr WideInteger Highest = static_cast<WideInteger>(std::numeric_limits<To>::max());
+
+  if constexpr (std::is_same_v<OverflowT, Overflow::Saturate>)
+  {
+    result = result < Lowest ? Lowest : result;
+    result = result > Highest ? Highest : result;
+  }
+  else if constexpr (std::is_same_v<OverflowT, Overflow::Checked>)
+  {
+    if (result < Lowest || result > Highest)
+    {
+      throw std::overflow_error("MetaMeasure: converted value doesn't fit in the value type");
+    }
+  }
+  else
+  {
+    static_assert(std::is_same_v<OverflowT, Overflow::Unchecked>, "Unknown overflow policy.");
+  }
+
+  return static_cast<To>(result);
+}
+
+// Scales an integer by a ratio exactly, then rounds and narrows it into a To
+// Everything that depends on the ratio is worked out at compile time, so what's left is straight-line integer code.
+// From can also be WideInteger, for products of 2 integers that are only narrowed once they've been scaled.
+template<typename To, Rational Ratio, typename RoundingT, typename OverflowT, typename From>
+constexpr To scaleInteger(const From& value)
+{
+  constexpr bool IsWide = std::is_same_v<From, WideInteger>;
+
+  static_assert(std::is_integral_v<To> && (std::is_integral_v<From> || IsWide),
+                "Only integer measurements can be converted with rounding and overflow policies.");
+  static_assert(Ratio.num > 0, "Conversion ratios are always positive.");
+  static_assert(Private::fitsInRatio(Ratio),
+                "Integer measurements can't be converted with a ratio that doesn't fit in 64 bits.");
+
+  // Unsigned values are worked on as unsigned, so ones past intmax_t's range still convert
+  using Narrow = std::conditional_t<IsWide, WideInteger,
+                                    std::conditional_t<std::is_signed_v<From>, std::intmax_t, std::uintmax_t>>;
+  constexpr Narrow Num = static_cast<Narrow>(Ratio.num);
+  constexpr Narrow Den = static_cast<Narrow>(Ratio.den);
+
+  WideInteger result;
+  WideInteger remainder;
+
+  if constexpr (Ratio.den == 1)
+  {
+    result = static_cast<WideInteger>(value) * Num;
+    remainder = 0;
+  }
+  else if constexpr (IsWide || Private::productFits(Ratio.num, Ratio.den))
+  {
+    // value * num / den is split into (q * den + r) * num / den, which is q * num + r * num / den
+    // r is smaller than den, so r * num can't overflow, and every division is by a constant that fits in 64 bits.
+    // (Both fit in 64 bits, so r * num always fits when it's worked out in WideInteger.)
+    Narrow n = static_cast<Narrow>(value);
+    Narrow scaledRemainder = (n % Den) * Num;
+
+    result = static_cast<WideInteger>(n / Den) * Num + scaledRemainder / Den;
+    remainder = static_cast<WideInteger>(scaledRemainder % Den);
+  }
+  else
+  {
+    // The ratio is too big to split, so this divides the whole 128-bit product instead
+    WideInteger product = static_cast<WideInteger>(value) * Num;
+
+    result = product / Den;
+    remainder = product % Den;
+  }
+
+  return Private::narrowQuotient<To, RoundingT, OverflowT>(result, remainder, static_cast<WideInteger>(Den));
+}
+
+// Divides 2 integers exactly, then rounds and narrows the quotient into a To like scaleInteger does
+template<typename To, typename RoundingT, typename OverflowT>
+constexpr To divideInteger(WideInteger dividend, WideInteger divisor)
+{
+  if (divisor < 0)
+  {
+    dividend = -dividend;
+    divisor = -divisor;
+  }
+
+  return Private::narrowQuotient<To, RoundingT, OverflowT>(dividend / divisor, dividend % divisor, divisor);
+}
+
+// Rounds a floating point value that's about to become an integer
+// Batch conversions do the exact same operations in their kernels, so every instruction set gives the same results.
+template<typename RoundingT, typename T>
+inline T round(T value)
+{
+  if constexpr (std::is_same_v<RoundingT, Rounding::Floor>)
+  {
+    return std::floor(value);
+  }
+  else if constexpr (std::is_same_v<RoundingT, Rounding::Nearest>)
+  {
+    // trunc(2 * d) is 1 or -1 exactly when the part that was cut off is at least a half
+    T truncated = std::trunc(value);
+    T cutOff = value - truncated;
+    return truncated + std::trunc(cutOff + cutOff);
+  }
+  else
+  {
+    static_assert(std::is_same_v<RoundingT, Rounding::Truncate>, "Unknown rounding mode.");
+    return std::trunc(value);
+  }
+}
+
+// Narrows a floating point value that's already been rounded into a To, with the same overflow policies as scaleInteger
+template<typename To, typename OverflowT, typename T>
+constexpr To narrowRounded(T value)
+{
+  // Both limits are 0 or powers of 2, so they're exact in any floating point type
+  constexpr T Lowest = static_cast<T>(std::numeric_limits<To>::lowest());
+  constexpr T PastHighest = static_cast<T>(std::numeric_limits<To>::max() / 2 + 1) * 2;
+
+  if constexpr (std::is_same_v<OverflowT, Overflow::Saturate>)
+  {
+    if (value != value) return To(0);
+    if (value < Lowest) return std::numeric_limits<To>::lowest();
+    if (value >= PastHighest) return std::numeric_limits<To>::max();
+  }
+  else if constexpr (std::is_same_v<OverflowT, Overflow::Checked>)
+  {
+    if (!(value >= Lowest && value < PastHighest))
+    {
+      throw std::overflow_error("MetaMeasure: converted value doesn't fit in the value type");
+    }
+  }
+  else
+  {
+    static_assert(std::is_same_v<OverflowT, Overflow::Unchecked>, "Unknown overflow policy.");
+  }
+
+  return static_cast<To>(value);
+}
+
+// A ratio as a single number of type NumT, rounded once at compile time
+// Multiplying by this is all a conversion costs for floating point value types
+template<typename NumT, Rational Ratio>
+inline constexpr NumT ConversionFactor = static_cast<NumT>(static_cast<long double>(Ratio.num) / Ratio.den);
+
+// Scales a value by a ratio
+// A ratio of 1 does nothing at all, integers go through scaleInteger (truncating, like they always have),
+// And everything else is multiplied by ConversionFactor.
+template<typename NumT, Rational Ratio>
+constexpr NumT applyRatio(const NumT& value)
+{
+  if constexpr (Ratio == Rational())
+  {
+    return value;
+  }
+  else if constexpr (std::is_integral_v<NumT>)
+  {
+    return Private::scaleInteger<NumT, Ratio, Rounding::Truncate, Overflow::Unchecked>(value);
+  }
+  else
+  {
+    return value * ConversionFactor<NumT, Ratio>;
+  }
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef METAMEASURE_DYNAMIC_INCLUDED
+#define METAMEASURE_DYNAMIC_INCLUDED
+
+// Measurements whose dimensions are only known at runtime, like the result of a formula a user typed in
+// The 7 exponents are packed into a single 64-bit word, 1 signed byte each,
+// So multiplying 2 of these adds their exponents with 1 integer addition, and checking their dimensions is 1 comparison.
+
+#include <MetaMeasure.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// The exponents of the 7 dimensions, as signed 8-bit lanes of a 64-bit word
+// Lane i holds the exponent of dimension i (see DimensionOrder), and the top lane is always 0.
+class PackedDimensions
+{
+  // The sign bit of every lane
+  static constexpr std::uint64_t SignBits = 0x8080808080808080;
+
+public:
+  constexpr PackedDimensions() = default;
+
+  // Packs the exponents of a dimension vector
+  // Throws a std::overflow_error (or fails to compile, if it's a constant) if an exponent doesn't fit in 8 bits.
+  constexpr explicit PackedDimensions(const DimensionVector& dimensions)
+  {
+    for (std::size_t i = 0; i < DimensionCount; ++i)
+    {
+      ExponentType exponent = dimensions.exponents[i];
+
+      if (exponent < -128 || exponent > 127)
+      {
+        throw std::overflow_error("MetaMeasure: a dimension's exponent doesn't fit in a dynamic measurement");
+      }
+
+      this->w |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(exponent)) << (8 * i);
+    }
+  }
+
+  constexpr ExponentType exponent(std::size_t dimension) const
+  {
+    return static_cast<std::int8_t>(static_cast<std::uint8_t>(this->w >> (8 * dimension)));
+  }
+
+  constexpr std::uint64_t word() const { return this->w; }
+  constexpr bool dimensionless() const { return this->w == 0; }
+
+  // Adds the exponents lane by lane, which is what multiplying measurements does to them
+  // The sign bits are left out of the addition so no lane carries into the next, then put back with an xor.
+  friend constexpr PackedDimensions operator+(const PackedDimensions& l, const PackedDimensions& r)
+  {
+    std::uint64_t sum = ((l.w & ~SignBits) + (r.w & ~SignBits)) ^ ((l.w ^ r.w) & SignBits);
+
+    // A lane overflowed if both of its exponents have the same sign and the sum doesn't
+    PackedDimensions::checkOverflow((l.w ^ sum) & (r.w ^ sum));
+    return PackedDimensions(sum);
+  }
+
+  // Subtracts the exponents lane by lane, which is what dividing measurements does to them
+  // Setting the sign bits of l first means no lane borrows from the next.
+  friend constexpr PackedDimensions operator-(const PackedDimensions& l, const PackedDimensions& r)
+  {
+    std::uint64_t difference = ((l.w | SignBits) - (r.w & ~SignBits)) ^ ((l.w ^ ~r.w) & SignBits);
+
+    // A lane overflowed if its exponents have different signs and the difference has r's sign
+    PackedDimensions::checkOverflow((l.w ^ r.w) & (l.w ^ difference));
+    return PackedDimensions(difference);
+  }
+
+  friend constexpr bool operator==(const PackedDimensions&, const PackedDimensions&) = default;
+
+private:
+  std::uint64_t w = 0;
+
+  constexpr explicit PackedDimensions(std::uint64_t word) : w(word) {}
+
+  static constexpr void checkOverflow(std::uint64_t signs)
+  {
+    if ((signs & SignBits) != 0)
+    {
+      throw std::overflow_error("MetaMeasure: a dimension's exponent doesn't fit in a dynamic measurement");
+    }
+  }
+};
+
+namespace Private
+{
+
+// The packed exponents of a measurement type, worked out at compile time
+template<DimensionVector DimensionsV>
+inline constexpr PackedDimensions PackedDimensionsOf = PackedDimensions(DimensionsV);
+
+}
+
+// A measurement whose dimensions are only known at runtime
+// It holds a value, how many base units 1 of its unit is (its scale), and its dimensions' exponents.
+// Measurements convert into these implicitly, and back with as<M>(), which checks the dimensions first.
+// Anything that needs the dimensions to match (adding, comparing, converting) throws a std::invalid_argument when they don't.
+template<typename NumT = double>
+class DynamicMeasurement
+{
+  static_assert(std::is_floating_point_v<NumT>, "Dynamic measurements need a floating point value type for their scale.");
+
+  using ThisType = DynamicMeasurement<NumT>;
+
+  // If the type is a measurement, overloads that use this type may be called
+  template<typename M, typename T = int>
+  using IfMeasurement = std::enable_if_t<Private::IsMeasurement<M>::value, T>;
+
+  // If the type is a plain number, overloads that use this type may be called
+  template<typename U, typename T = char>
+  using IfScalar = std::enable_if_t<Private::IsScalar<U>::value, T>;
+
+public:
+  using ValueType = NumT;
+
+  constexpr DynamicMeasurement() = default;
+
+  constexpr DynamicMeasurement(NumT value, PackedDimensions dimensions, NumT scale = 1)
+    : v(value), s(scale), d(dimensions)
+  {}
+
+  // Keeps the measurement's value and units, so converting back into the same type is exact
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr DynamicMeasurement(const M& measurement)
+    : v(static_cast<NumT>(measurement.value())),
+      s(ThisType::scaleOf<M>()),
+      d(ThisType::dimensionsOf<M>())
+  {}
+
+  constexpr const NumT& value() const { return this->v; }
+  constexpr const NumT& scale() const { return this->s; }
+  constexpr PackedDimensions dimensions() const { return this->d; }
+
+  // The value in base units
+  constexpr NumT baseValue() const { return this->v * this->s; }
+
+  // Checks if this has the same dimensions as M, with a single comparison
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr bool is() const
+  {
+    return this->d == ThisType::dimensionsOf<M>();
+  }
+
+  // Converts this into M, or throws a std::invalid_argument if it doesn't have M's dimensions
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr M as() const
+  {
+    if (!this->is<M>())
+    {
+      throw std::invalid_argument("MetaMeasure: a dynamic measurement doesn't have the dimensions of the measurement it's converted into");
+    }
+
+    constexpr DimensionVector Dimensions = M::Dimensions;
+    constexpr NumT ToRatio = Private::ConversionFactor<NumT, Dimensions.ratio>;
+    return M(static_cast<typename M::ValueType>(this->v * (this->s * ToRatio)));
+  }
+
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr explicit operator M() const
+  {
+    return this->as<M>();
+  }
+
+  // Arithmetic operators
+  // Results keep the left operand's units when it has them, so a sum of kilometers stays in kilometers.
+  friend constexpr ThisType operator+(const ThisType& l, const ThisType& r)
+  {
+    return ThisType(l.v + r.in(l), l.d, l.s);
+  }
+
+  friend constexpr ThisType operator-(const ThisType& l, const ThisType& r)
+  {
+    return ThisType(l.v - r.in(l), l.d, l.s);
+  }
+
+  friend constexpr ThisType operator*(const ThisType& l, const ThisType& r)
+  {
+    return ThisType(l.v * r.v, l.d + r.d, l.s * r.s);
+  }
+
+  friend constexpr ThisType operator/(const ThisType& l, const ThisType& r)
+  {
+    return ThisType(l.v / r.v, l.d - r.d, l.s / r.s);
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr ThisType operator*(const ThisType& l, const NumU& r)
+  {
+    return ThisType(l.v * r, l.d, l.s);
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr ThisType operator*(const NumU& l, const ThisType& r)
+  {
+    return ThisType(l * r.v, r.d, r.s);
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr ThisType operator/(const ThisType& l, const NumU& r)
+  {
+    return ThisType(l.v / r, l.d, l.s);
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr ThisType operator/(const NumU& l, const ThisType& r)
+  {
+    return ThisType(l / r.v, PackedDimensions() - r.d, 1 / r.s);
+  }
+
+  friend constexpr ThisType operator-(const ThisType& m)
+  {
+    return ThisType(-m.v, m.d, m.s);
+  }
+
+  // Assignment operators
+  constexpr ThisType& operator+=(const ThisType& other) { return *this = *this + other; }
+  constexpr ThisType& operator-=(const ThisType& other) { return *this = *this - other; }
+  constexpr ThisType& operator*=(const ThisType& other) { return *this = *this * other; }
+  constexpr ThisType& operator/=(const ThisType& other) { return *this = *this / other; }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType& operator*=(const NumU& factor)
+  {
+    this->v *= factor;
+    return *this;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType& operator/=(const NumU& divisor)
+  {
+    this->v /= divisor;
+    return *this;
+  }
+
+  // Comparison operators
+  // Measurements are compared in base units, so 1 km == 1000 m.
+  friend constexpr bool operator==(const ThisType& l, const ThisType& r) { return l.v == r.in(l); }
+  friend constexpr bool operator!=(const ThisType& l, const ThisType& r) { return l.v != r.in(l); }
+  friend constexpr bool operator<(const ThisType& l, const ThisType& r) { return l.v < r.in(l); }
+  friend constexpr bool operator<=(const ThisType& l, const ThisType& r) { return l.v <= r.in(l); }
+  friend constexpr bool operator>(const ThisType& l, const ThisType& r) { return l.v > r.in(l); }
+  friend constexpr bool operator>=(const ThisType& l, const ThisType& r) { return l.v >= r.in(l); }
+
+private:
+  NumT v = 0;
+  NumT s = 1;
+  PackedDimensions d;
+
+  template<typename M>
+  static constexpr NumT scaleOf()
+  {
+    constexpr DimensionVector Dimensions = M::Dimensions;
+    return Private::ConversionFactor<NumT, Rational() / Dimensions.ratio>;
+  }
+
+  template<typename M>
+  static constexpr PackedDimensions dimensionsOf()
+  {
+    constexpr DimensionVector Dimensions = M::Dimensions;
+    return Private::PackedDimensionsOf<Dimensions>;
+  }
+
+  // This value in other's units, after checking the dimensions match
+  constexpr NumT in(const ThisType& other) const
+  {
+    if (this->d != other.d)
+    {
+      throw std::invalid_argument("MetaMeasure: dynamic measurements with different dimensions can't be added or compared");
+    }
+
+    return this->s == other.s ? this->v : this->v * (this->s / other.s);
+  }
+};
+
+namespace Private
+{
+
+template<typename NumT>
+struct IsDynamicMeasurement<DynamicMeasurement<NumT>> : std::true_type {};
+
+}
+
+}
+
+#endif
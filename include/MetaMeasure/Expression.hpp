@@ -0,0 +1,571 @@
+#ifndef METAMEASURE_EXPRESSION_INCLUDED
+#define METAMEASURE_EXPRESSION_INCLUDED
+
+// Expressions of measurements that are only evaluated once they're complete
+// Every node carries the dimensions of its result and the ratio it still has to be scaled by,
+// So a whole chain like a * b / c + d costs one multiply for all of its conversions,
+// And arrays are evaluated in a single pass without any arrays in between.
+
+#include <MetaMeasure/Literals.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Tells the compiler that a pointer doesn't overlap any other one in the same function
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define METAMEASURE_RESTRICT __restrict
+#else
+#define METAMEASURE_RESTRICT
+#endif
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+template<typename NumT, DimensionVector DimensionsV, typename AllocatorT>
+class BasicMeasurementArray;
+
+namespace Private
+{
+
+template<typename NodeT>
+inline constexpr bool IsArrayNode = NodeT::IsArray;
+
+}
+
+template<typename NodeT, bool IsArray = Private::IsArrayNode<NodeT>>
+class Expression;
+
+namespace Private
+{
+
+template<typename NodeT, bool IsArray>
+struct IsMeasurementExpression<Expression<NodeT, IsArray>> : std::true_type {};
+
+template<typename T>
+struct IsMeasurementConstant : std::false_type {};
+
+template<DimensionVector DimensionsV>
+struct IsMeasurementConstant<MeasurementConstant<DimensionsV>> : std::true_type {};
+
+template<typename AllocatorT, typename T>
+using ReboundAllocator = typename std::allocator_traits<AllocatorT>::template rebind_alloc<T>;
+
+// The array holding results of type T
+// Results without dimensions are plain numbers, so they go in a std::vector instead
+template<typename T, typename AllocatorT, bool = IsMeasurement<T>::value>
+struct ArrayOf_
+{
+  using Type = std::vector<T, ReboundAllocator<AllocatorT, T>>;
+};
+
+template<typename M, typename AllocatorT>
+struct ArrayOf_<M, AllocatorT, true>
+{
+  using ValueType = typename M::ValueType;
+  using Type = BasicMeasurementArray<ValueType, M::Dimensions, ReboundAllocator<AllocatorT, ValueType>>;
+};
+
+template<typename T, typename AllocatorT>
+using ArrayOf = typename ArrayOf_<T, AllocatorT>::Type;
+
+// The value of a measurement, or the number itself if the dimensions canceled out
+template<typename T>
+constexpr auto bareValue(const T& x)
+{
+  if constexpr (IsMeasurement<T>::value) return x.value();
+  else return x;
+}
+
+// Every node has
+// ValueType, the type it computes in (always the one of its left operand, like measurements),
+// Dimensions, the dimensions and units of its result,
+// Ratio, what raw(i) still has to be scaled by to be in those units,
+// IsArray and size(), and if it's an array, AllocatorType and allocator().
+//
+// Only floating point nodes put off their ratios; integer ones are scaled right away like measurements are,
+// So they round at the same steps and give the same results.
+template<typename NodeT>
+inline constexpr bool Folds = std::is_floating_point_v<typename NodeT::ValueType>;
+
+// The value a node stands for at index i, in the node's units
+template<typename NodeT>
+constexpr auto nodeValue(const NodeT& node, std::size_t i)
+{
+  return applyRatio<typename NodeT::ValueType, NodeT::Ratio>(node.raw(i));
+}
+
+// The same value as the measurement (or plain number) it is
+template<typename NodeT>
+constexpr auto measurementAt(const NodeT& node, std::size_t i)
+{
+  // GCC 12 crashes if NodeT::Dimensions is used as a template argument here directly
+  constexpr DimensionVector Dimensions = NodeT::Dimensions;
+  return MeasurementFromDimensions<typename NodeT::ValueType, Dimensions>(nodeValue(node, i));
+}
+
+// The value a node stands for at index i, as a ToT in ToDimensions
+// When both are floating point, this is a single multiply by every ratio the expression had.
+template<typename ToT, DimensionVector ToDimensions, typename NodeT>
+constexpr ToT finalValue(const NodeT& node, std::size_t i)
+{
+  if constexpr (std::is_floating_point_v<ToT> && Folds<NodeT>)
+  {
+    constexpr Rational Ratio = NodeT::Ratio * ConversionRatio<NodeT::Dimensions, ToDimensions>;
+    return applyRatio<ToT, Ratio>(static_cast<ToT>(node.raw(i)));
+  }
+  else
+  {
+    using To = MeasurementFromDimensions<ToT, ToDimensions>;
+    return bareValue(To(measurementAt(node, i)));
+  }
+}
+
+// A single measurement, which is the same at every index
+template<typename M>
+struct MeasurementLeaf
+{
+  using ValueType = typename M::ValueType;
+  static constexpr DimensionVector Dimensions = M::Dimensions;
+  static constexpr Rational Ratio = Rational();
+  static constexpr bool IsArray = false;
+
+  ValueType v;
+
+  constexpr ValueType raw(std::size_t) const { return this->v; }
+  constexpr std::size_t size() const { return 1; }
+};
+
+template<typename A>
+struct ArrayLeaf
+{
+  using ValueType = typename A::ValueType;
+  using AllocatorType = typename A::AllocatorType;
+  static constexpr DimensionVector Dimensions = A::Dimensions;
+  static constexpr Rational Ratio = Rational();
+  static constexpr bool IsArray = true;
+
+  const A* array;
+  const ValueType* values;
+
+  explicit ArrayLeaf(const A& a) : array(&a), values(a.data()) {}
+
+  ValueType raw(std::size_t i) const { return this->values[i]; }
+  std::size_t size() const { return this->array->size(); }
+  AllocatorType allocator() const { return this->array->allocator(); }
+};
+
+// What every node with 2 operands has in common
+template<typename L, typename R>
+struct BinaryNode
+{
+  static constexpr bool IsArray = L::IsArray || R::IsArray;
+
+  L l;
+  R r;
+
+  constexpr BinaryNode(const L& left, const R& right)
+    : l(left), r(right)
+  {
+    if constexpr (L::IsArray && R::IsArray)
+    {
+      if (left.size() != right.size())
+      {
+        throw std::length_error("MetaMeasure: arrays of different sizes can't be combined");
+      }
+    }
+  }
+
+  constexpr std::size_t size() const
+  {
+    if constexpr (L::IsArray) return this->l.size();
+    else return this->r.size();
+  }
+
+  auto allocator() const
+  {
+    if constexpr (L::IsArray) return this->l.allocator();
+    else return this->r.allocator();
+  }
+};
+
+// Nodes with 1 operand pass everything about arrays through
+template<typename L>
+struct UnaryNode
+{
+  static constexpr bool IsArray = L::IsArray;
+
+  L l;
+
+  constexpr std::size_t size() const { return this->l.size(); }
+  auto allocator() const { return this->l.allocator(); }
+};
+
+template<typename L, typename R, bool Subtract>
+struct SumNode : BinaryNode<L, R>
+{
+  static_assert(L::Dimensions.sameDimensions(R::Dimensions),
+                "Only measurements with the same dimensions can be added or subtracted.");
+
+  using BinaryNode<L, R>::BinaryNode;
+  using ValueType = typename L::ValueType;
+  static constexpr DimensionVector Dimensions = L::Dimensions;
+  static constexpr Rational Ratio = Folds<L> ? L::Ratio : Rational();
+
+  // What the right side is scaled by to be in the same units as the left one, before its ratio is applied
+  static constexpr Rational RightRatio = R::Ratio * ConversionRatio<R::Dimensions, L::Dimensions> / L::Ratio;
+
+  constexpr ValueType raw(std::size_t i) const
+  {
+    if constexpr (Folds<L>)
+    {
+      ValueType right = applyRatio<ValueType, RightRatio>(static_cast<ValueType>(this->r.raw(i)));
+      return Subtract ? this->l.raw(i) - right : this->l.raw(i) + right;
+    }
+    else
+    {
+      auto left = measurementAt(this->l, i);
+      auto right = measurementAt(this->r, i);
+      return static_cast<ValueType>(bareValue(Subtract ? left - right : left + right));
+    }
+  }
+};
+
+template<typename L, typename R>
+using AddNode = SumNode<L, R, false>;
+
+template<typename L, typename R>
+using SubtractNode = SumNode<L, R, true>;
+
+template<typename L, typename R>
+struct ProductNode : BinaryNode<L, R>
+{
+  using BinaryNode<L, R>::BinaryNode;
+  using ValueType = typename L::ValueType;
+  static constexpr DimensionVector Dimensions = L::Dimensions * R::Dimensions;
+  static constexpr Rational Ratio = Folds<L> ? L::Ratio * R::Ratio * ProductRatio<L::Dimensions, R::Dimensions>
+                                             : Rational();
+
+  constexpr ValueType raw(std::size_t i) const
+  {
+    if constexpr (Folds<L>)
+    {
+      return this->l.raw(i) * static_cast<ValueType>(this->r.raw(i));
+    }
+    else
+    {
+      auto left = measurementAt(this->l, i);
+      auto right = measurementAt(this->r, i);
+      return static_cast<ValueType>(bareValue(left * right));
+    }
+  }
+};
+
+template<typename L, typename R>
+struct QuotientNode : BinaryNode<L, R>
+{
+  using BinaryNode<L, R>::BinaryNode;
+  using ValueType = typename L::ValueType;
+  static constexpr DimensionVector Dimensions = L::Dimensions / R::Dimensions;
+  static constexpr Rational Ratio = Folds<L> ? L::Ratio / R::Ratio * QuotientRatio<L::Dimensions, R::Dimensions>
+                                             : Rational();
+
+  constexpr ValueType raw(std::size_t i) const
+  {
+    if constexpr (Folds<L>)
+    {
+      return this->l.raw(i) / static_cast<ValueType>(this->r.raw(i));
+    }
+    else
+    {
+      auto left = measurementAt(this->l, i);
+      auto right = measurementAt(this->r, i);
+      return static_cast<ValueType>(bareValue(left / right));
+    }
+  }
+};
+
+// A node multiplied or divided by a plain number, which doesn't change its units
+template<typename L, typename NumU, bool Divide>
+struct ScaledNode : UnaryNode<L>
+{
+  using ValueType = typename L::ValueType;
+  static constexpr DimensionVector Dimensions = L::Dimensions;
+  static constexpr Rational Ratio = L::Ratio;
+
+  NumU factor;
+
+  constexpr ScaledNode(const L& left, const NumU& f) : UnaryNode<L>{left}, factor(f) {}
+
+  constexpr ValueType raw(std::size_t i) const
+  {
+    if constexpr (Divide) return static_cast<ValueType>(this->l.raw(i) / this->factor);
+    else return static_cast<ValueType>(this->l.raw(i) * this->factor);
+  }
+};
+
+// A plain number divided by a node
+template<typename NumU, typename R>
+struct ReciprocalNode : UnaryNode<R>
+{
+  using ValueType = typename R::ValueType;
+  static constexpr DimensionVector Dimensions = R::Dimensions.reciprocal();
+  static constexpr Rational Ratio = Rational() / R::Ratio;
+
+  NumU dividend;
+
+  constexpr ReciprocalNode(const NumU& d, const R& right) : UnaryNode<R>{right}, dividend(d) {}
+
+  constexpr ValueType raw(std::size_t i) const
+  {
+    return static_cast<ValueType>(this->dividend / this->l.raw(i));
+  }
+};
+
+template<typename L>
+struct NegatedNode : UnaryNode<L>
+{
+  using ValueType = typename L::ValueType;
+  static constexpr DimensionVector Dimensions = L::Dimensions;
+  static constexpr Rational Ratio = L::Ratio;
+
+  constexpr explicit NegatedNode(const L& left) : UnaryNode<L>{left} {}
+
+  constexpr ValueType raw(std::size_t i) const
+  {
+    return -this->l.raw(i);
+  }
+};
+
+// The node for an operand of an expression
+// Literal constants take on the value type of the other operand, like they do with measurements.
+template<typename PartnerT, typename T>
+constexpr auto nodeOf(const T& x)
+{
+  if constexpr (IsMeasurementExpression<T>::value)
+  {
+    return x.node();
+  }
+  else if constexpr (IsMeasurementArray<T>::value)
+  {
+    return ArrayLeaf<T>(x);
+  }
+  else if constexpr (IsMeasurementConstant<T>::value)
+  {
+    using M = BasicMeasurement<PartnerT, T::Dimensions>;
+    return MeasurementLeaf<M>{M(x).value()};
+  }
+  else
+  {
+    return MeasurementLeaf<T>{x.value()};
+  }
+}
+
+template<template<typename, typename> typename NodeT, typename L, typename R>
+constexpr auto combine(const L& l, const R& r)
+{
+  auto left = Private::nodeOf<typename R::ValueType>(l);
+  auto right = Private::nodeOf<typename L::ValueType>(r);
+  using Node = NodeT<decltype(left), decltype(right)>;
+  return Expression<Node>(Node(left, right));
+}
+
+// Evaluates an array node into out, which can't overlap any array the node reads
+template<typename ToT, DimensionVector ToDimensions, typename NodeT>
+inline void evaluate(ToT* METAMEASURE_RESTRICT out, const NodeT& node, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = Private::finalValue<ToT, ToDimensions>(node, i);
+}
+
+// Same, but out may be one of the arrays the node reads (a = a * 2 + b)
+// That's fine since every element only reads the ones at the same index.
+template<typename ToT, DimensionVector ToDimensions, typename NodeT>
+inline void evaluateInPlace(ToT* out, const NodeT& node, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = Private::finalValue<ToT, ToDimensions>(node, i);
+}
+
+// If either operand brings its own operators and both are measurements of some sort,
+// Operators that use this type may be called
+template<typename L, typename R, typename T = int>
+using IfExpressionOperands = std::enable_if_t
+<
+  (HasOwnOperators<L>::value || HasOwnOperators<R>::value) &&
+  (HasOwnOperators<L>::value || IsMeasurement<L>::value) &&
+  (HasOwnOperators<R>::value || IsMeasurement<R>::value),
+  T
+>;
+
+// If L brings its own operators and NumU is a plain number, operators that use this type may be called
+template<typename L, typename NumU, typename T = char>
+using IfScaledExpression = std::enable_if_t
+<
+  HasOwnOperators<L>::value && IsScalar<NumU>::value,
+  T
+>;
+
+}
+
+// An expression of single measurements
+// It acts like the measurement it evaluates to, so it can initialize one or be used with one.
+template<typename NodeT>
+class Expression<NodeT, false>
+{
+public:
+  using ValueType = typename NodeT::ValueType;
+  static constexpr DimensionVector Dimensions = NodeT::Dimensions;
+  using UnitTuple = Private::UnitTuple<Dimensions>;
+
+  // What the expression evaluates to
+  using Result = Private::MeasurementFromDimensions<ValueType, Dimensions>;
+
+  constexpr explicit Expression(const NodeT& node) : n(node) {}
+
+  constexpr const NodeT& node() const { return this->n; }
+  constexpr ValueType value() const { return Private::nodeValue(this->n, 0); }
+  constexpr Result eval() const { return Result(this->value()); }
+
+  // Expressions without dimensions are plain numbers
+  constexpr operator ValueType() const requires (Dimensions.dimensionless())
+  {
+    return this->value();
+  }
+
+private:
+  NodeT n;
+};
+
+// An expression of arrays, evaluated one element at a time
+// Assigning it to an array (or calling eval()) evaluates it in a single loop.
+// It only refers to the arrays in it, so it shouldn't outlive them.
+template<typename NodeT>
+class Expression<NodeT, true>
+{
+public:
+  using ValueType = typename NodeT::ValueType;
+  static constexpr DimensionVector Dimensions = NodeT::Dimensions;
+  using AllocatorType = decltype(std::declval<const NodeT&>().allocator());
+
+  using Element = Private::MeasurementFromDimensions<ValueType, Dimensions>;
+  using Result = Private::ArrayOf<Element, AllocatorType>;
+
+  explicit Expression(const NodeT& node) : n(node) {}
+
+  const NodeT& node() const { return this->n; }
+  std::size_t size() const { return this->n.size(); }
+  AllocatorType allocator() const { return this->n.allocator(); }
+
+  // Only evaluates the element at i
+  Element operator[](std::size_t i) const
+  {
+    return Element(Private::finalValue<ValueType, Dimensions>(this->n, i));
+  }
+
+  Result eval() const
+  {
+    Result result(this->size(), Private::ReboundAllocator<AllocatorType, ValueType>(this->allocator()));
+    this->evaluateInto<ValueType, Dimensions>(result.data());
+    return result;
+  }
+
+  // Expressions without dimensions evaluate to a std::vector of plain numbers
+  template<typename AllocatorU>
+  operator std::vector<ValueType, AllocatorU>() const requires (Dimensions.dimensionless())
+  {
+    std::vector<ValueType, AllocatorU> result(this->size());
+    this->evaluateInto<ValueType, Dimensions>(result.data());
+    return result;
+  }
+
+  // Writes every element to out as a ToT in ToDimensions
+  // If out may be one of the arrays in the expression, MayAlias has to be true.
+  template<typename ToT, DimensionVector ToDimensions, bool MayAlias = false>
+  void evaluateInto(ToT* out) const
+  {
+    if constexpr (MayAlias) Private::evaluateInPlace<ToT, ToDimensions>(out, this->n, this->size());
+    else Private::evaluate<ToT, ToDimensions>(out, this->n, this->size());
+  }
+
+private:
+  NodeT n;
+};
+
+// Starts an expression of single measurements
+// Every conversion ratio in it is folded into one multiply, instead of one for every operator:
+// Meters<double> x = lazy(a) * b / c + d;
+template<typename M, std::enable_if_t<Private::IsMeasurement<M>::value, int> = 0>
+constexpr auto lazy(const M& m)
+{
+  using Node = Private::MeasurementLeaf<M>;
+  return Expression<Node>(Node{m.value()});
+}
+
+// Arithmetic operators for arrays and expressions
+// With measurements, arrays and other expressions, the result is another expression.
+template<typename L, typename R, Private::IfExpressionOperands<L, R> = 0>
+constexpr auto operator+(const L& l, const R& r)
+{
+  return Private::combine<Private::AddNode>(l, r);
+}
+
+template<typename L, typename R, Private::IfExpressionOperands<L, R> = 0>
+constexpr auto operator-(const L& l, const R& r)
+{
+  return Private::combine<Private::SubtractNode>(l, r);
+}
+
+template<typename L, typename R, Private::IfExpressionOperands<L, R> = 0>
+constexpr auto operator*(const L& l, const R& r)
+{
+  return Private::combine<Private::ProductNode>(l, r);
+}
+
+template<typename L, typename R, Private::IfExpressionOperands<L, R> = 0>
+constexpr auto operator/(const L& l, const R& r)
+{
+  return Private::combine<Private::QuotientNode>(l, r);
+}
+
+template<typename L, typename NumU, Private::IfScaledExpression<L, NumU> = 0>
+constexpr auto operator*(const L& l, const NumU& factor)
+{
+  auto left = Private::nodeOf<NumU>(l);
+  using Node = Private::ScaledNode<decltype(left), NumU, false>;
+  return Expression<Node>(Node(left, factor));
+}
+
+template<typename NumU, typename R, Private::IfScaledExpression<R, NumU> = 0>
+constexpr auto operator*(const NumU& factor, const R& r)
+{
+  return r * factor;
+}
+
+template<typename L, typename NumU, Private::IfScaledExpression<L, NumU> = 0>
+constexpr auto operator/(const L& l, const NumU& divisor)
+{
+  auto left = Private::nodeOf<NumU>(l);
+  using Node = Private::ScaledNode<decltype(left), NumU, true>;
+  return Expression<Node>(Node(left, divisor));
+}
+
+template<typename NumU, typename R, Private::IfScaledExpression<R, NumU> = 0>
+constexpr auto operator/(const NumU& dividend, const R& r)
+{
+  auto right = Private::nodeOf<NumU>(r);
+  using Node = Private::ReciprocalNode<NumU, decltype(right)>;
+  return Expression<Node>(Node(dividend, right));
+}
+
+template<typename L, std::enable_if_t<Private::HasOwnOperators<L>::value, int> = 0>
+constexpr auto operator-(const L& l)
+{
+  auto left = Private::nodeOf<typename L::ValueType>(l);
+  using Node = Private::NegatedNode<decltype(left)>;
+  return Expression<Node>(Node(left));
+}
+
+}
+
+#endif
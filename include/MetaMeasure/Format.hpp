@@ -0,0 +1,274 @@
+#ifndef METAMEASURE_FORMAT_INCLUDED
+#define METAMEASURE_FORMAT_INCLUDED
+
+// Writing measurements as text, like "9.81 m·s⁻²"
+// Values are written with std::to_chars, and unit symbols are worked out at compile time from a measurement's dimensions,
+// So formatting a measurement doesn't allocate, doesn't depend on the locale and doesn't need iostreams.
+
+#include <MetaMeasure/Symbols.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <version>
+
+#ifdef __cpp_lib_format
+#include <format>
+#endif
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// How unit symbols are written
+namespace SymbolStyles
+{
+
+// Exponents are superscripts and units are joined by a middle dot, like m·s⁻², in UTF-8
+struct Unicode {};
+
+// Plain ASCII that parse() reads back (see MetaMeasure/Parse.hpp), like m*s^-2
+struct Ascii {};
+
+}
+
+namespace Private
+{
+
+namespace Formatting
+{
+
+// Where a symbol is written at compile time, before it's cut down to size
+struct SymbolBuffer
+{
+  char text[256] = {};
+  std::size_t length = 0;
+
+  constexpr void append(std::string_view s)
+  {
+    if (this->length + s.size() > sizeof(this->text))
+    {
+      throw std::length_error("MetaMeasure: a unit symbol is too long");
+    }
+
+    for (char c : s) this->text[this->length++] = c;
+  }
+
+  // Appends a number, with each digit picked from digits
+  constexpr void append(WideInteger n, const std::string_view (&digits)[10])
+  {
+    if (n >= 10) this->append(n / 10, digits);
+    this->append(digits[static_cast<std::size_t>(n % 10)]);
+  }
+};
+
+inline constexpr std::string_view Digits[10] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+
+// Superscript digits in UTF-8, spelled out as bytes so it doesn't matter what the compiler thinks the source encoding is
+inline constexpr std::string_view Superscripts[10] =
+{
+  "\xE2\x81\xB0", "\xC2\xB9", "\xC2\xB2", "\xC2\xB3", "\xE2\x81\xB4",
+  "\xE2\x81\xB5", "\xE2\x81\xB6", "\xE2\x81\xB7", "\xE2\x81\xB8", "\xE2\x81\xB9"
+};
+
+inline constexpr std::string_view SuperscriptMinus = "\xE2\x81\xBB";
+inline constexpr std::string_view MiddleDot = "\xC2\xB7";
+
+// Checks if a symbol is for a unit of a single dimension to the power of 1
+constexpr bool measuresOnly(const Symbols::Symbol& symbol, std::size_t dimension)
+{
+  for (std::size_t i = 0; i < DimensionCount; ++i)
+  {
+    if (symbol.exponents[i] != (i == dimension ? 1 : 0)) return false;
+  }
+
+  return true;
+}
+
+// Appends the symbol of the unit a dimension is measured in
+// Units without a literal are written as a multiple of the base unit, like (127/5000 m) for inches,
+// And so are units whose symbol is read as another unit, so the text always reads back as the same unit.
+constexpr void appendUnit(SymbolBuffer& buffer, std::size_t dimension, const Rational& scale)
+{
+  const Symbols::Symbol* base = nullptr;
+
+  for (const Symbols::Symbol& symbol : Symbols::AllSymbols)
+  {
+    if (!Formatting::measuresOnly(symbol, dimension) || !Symbols::isReadAs(symbol)) continue;
+
+    if (symbol.ratio == scale)
+    {
+      buffer.append(symbol.view());
+      return;
+    }
+
+    if (base == nullptr && symbol.ratio == Rational()) base = &symbol;
+  }
+
+  if (base == nullptr)
+  {
+    throw std::logic_error("MetaMeasure: there's no literal for the base unit of a dimension");
+  }
+
+  buffer.append("(");
+  buffer.append(scale.den, Digits);
+
+  if (scale.num != 1)
+  {
+    buffer.append("/");
+    buffer.append(scale.num, Digits);
+  }
+
+  buffer.append(" ");
+  buffer.append(base->view());
+  buffer.append(")");
+}
+
+template<typename StyleT>
+constexpr void appendExponent(SymbolBuffer& buffer, ExponentType exponent)
+{
+  if (exponent == 1) return;
+
+  if constexpr (std::is_same_v<StyleT, SymbolStyles::Unicode>)
+  {
+    if (exponent < 0) buffer.append(SuperscriptMinus);
+    buffer.append(exponent < 0 ? -exponent : exponent, Superscripts);
+  }
+  else
+  {
+    static_assert(std::is_same_v<StyleT, SymbolStyles::Ascii>, "Unknown symbol style.");
+
+    buffer.append("^");
+    if (exponent < 0) buffer.append("-");
+    buffer.append(exponent < 0 ? -exponent : exponent, Digits);
+  }
+}
+
+// Writes the symbol for a measurement's units, 1 dimension at a time in the order of DimensionOrder
+template<DimensionVector DimensionsV, typename StyleT>
+consteval SymbolBuffer writeSymbol()
+{
+  SymbolBuffer buffer;
+
+  for (std::size_t i = 0; i < DimensionCount; ++i)
+  {
+    if (DimensionsV.exponents[i] == 0) continue;
+
+    if (buffer.length != 0)
+    {
+      buffer.append(std::is_same_v<StyleT, SymbolStyles::Unicode> ? MiddleDot : std::string_view("*"));
+    }
+
+    Formatting::appendUnit(buffer, i, DimensionsV.scales[i]);
+    Formatting::appendExponent<StyleT>(buffer, DimensionsV.exponents[i]);
+  }
+
+  return buffer;
+}
+
+// The symbol, in an array that's exactly big enough for it
+template<DimensionVector DimensionsV, typename StyleT>
+inline constexpr auto SymbolText = []()
+{
+  constexpr SymbolBuffer Buffer = Formatting::writeSymbol<DimensionsV, StyleT>();
+
+  std::array<char, Buffer.length> text = {};
+  for (std::size_t i = 0; i < Buffer.length; ++i) text[i] = Buffer.text[i];
+  return text;
+}();
+
+// Writes a measurement's value with writeValue, then a space and its unit symbol
+template<typename StyleT, typename M, typename WriteValue>
+inline std::to_chars_result writeMeasurement(char* first, char* last, const M& measurement, WriteValue writeValue)
+{
+  static_assert(Private::IsMeasurement<M>::value, "Only measurements can be written with their units.");
+
+  constexpr DimensionVector Dimensions = M::Dimensions;
+  constexpr const auto& Symbol = Formatting::SymbolText<Dimensions, StyleT>;
+
+  std::to_chars_result result = writeValue(first, last, measurement.value());
+  if (result.ec != std::errc()) return result;
+
+  if (static_cast<std::size_t>(last - result.ptr) < Symbol.size() + 1)
+  {
+    return {last, std::errc::value_too_large};
+  }
+
+  *result.ptr++ = ' ';
+  result.ptr = std::copy(Symbol.begin(), Symbol.end(), result.ptr);
+  return result;
+}
+
+}
+
+}
+
+// The symbol for a measurement's units, like "m·s⁻¹" for meters per second
+// It's put together at compile time from the literals' suffixes (see MetaMeasure/Symbols.hpp),
+// And is a view of a constant, so it's valid for as long as the program runs.
+template<typename M, typename StyleT = SymbolStyles::Unicode>
+constexpr std::string_view unitSymbol()
+{
+  constexpr DimensionVector Dimensions = M::Dimensions;
+  constexpr const auto& Text = Private::Formatting::SymbolText<Dimensions, StyleT>;
+  return std::string_view(Text.data(), Text.size());
+}
+
+// Writes a measurement into [first, last) as its value, a space and its unit symbol, like "9.81 m·s⁻²"
+// The value is written like std::to_chars would, which is the shortest text that reads back as the same value.
+// Like std::to_chars, this gives back where the text ends, or std::errc::value_too_large if it didn't fit.
+template<typename StyleT = SymbolStyles::Unicode, typename M>
+inline std::to_chars_result toChars(char* first, char* last, const M& measurement)
+{
+  return Private::Formatting::writeMeasurement<StyleT>(first, last, measurement,
+    [](char* f, char* l, const auto& value) { return std::to_chars(f, l, value); });
+}
+
+// Same as above, with the value written in the given floating point format
+template<typename StyleT = SymbolStyles::Unicode, typename M>
+inline std::to_chars_result toChars(char* first, char* last, const M& measurement, std::chars_format format)
+{
+  return Private::Formatting::writeMeasurement<StyleT>(first, last, measurement,
+    [format](char* f, char* l, const auto& value) { return std::to_chars(f, l, value, format); });
+}
+
+// Same as above, with the value written in the given floating point format and precision
+template<typename StyleT = SymbolStyles::Unicode, typename M>
+inline std::to_chars_result toChars(char* first, char* last, const M& measurement, std::chars_format format, int precision)
+{
+  return Private::Formatting::writeMeasurement<StyleT>(first, last, measurement,
+    [format, precision](char* f, char* l, const auto& value) { return std::to_chars(f, l, value, format, precision); });
+}
+
+}
+
+#ifdef __cpp_lib_format
+
+namespace std
+{
+
+// Formats a measurement's value like its value type would, followed by a space and its unit symbol
+// So std::format("{:.1f}", 9.81_m / (1.0_s * 1.0_s)) gives "9.8 m·s⁻²"; the width and fill only apply to the value.
+template<typename NumT, MetaMeasure::DimensionVector DimensionsV>
+struct formatter<MetaMeasure::BasicMeasurement<NumT, DimensionsV>, char> : formatter<NumT, char>
+{
+  template<typename FormatContext>
+  auto format(const MetaMeasure::BasicMeasurement<NumT, DimensionsV>& measurement, FormatContext& context) const
+  {
+    constexpr std::string_view Symbol = MetaMeasure::unitSymbol<MetaMeasure::BasicMeasurement<NumT, DimensionsV>>();
+
+    auto out = formatter<NumT, char>::format(measurement.value(), context);
+    *out++ = ' ';
+    return std::copy(Symbol.begin(), Symbol.end(), out);
+  }
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef METAMEASURE_LITERALS_INCLUDED
+#define METAMEASURE_LITERALS_INCLUDED
+
+#include <MetaMeasure/Measurement.hpp>
+#include <MetaMeasure/UnitMacros.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// Want to use different types for literals?
+// Change these then!
+// To only change them for some literals, see MetaMeasureLiteralMode below instead.
+using LongDoubleLiteralResult = long double;
+using UnsignedLongLongLiteralResult = long long int;
+
+// A measurement from a literal that hasn't picked a value type yet
+// It takes on the value type of whatever measurement it's used with or used to initialize,
+// So 3.0_m * x with x being a Seconds<float> is done in float, not long double.
+// The literal itself is only stored as a long double, which the compiler folds away.
+template<DimensionVector DimensionsV>
+class MeasurementConstant
+{
+public:
+  using ValueType = long double;
+  static constexpr DimensionVector Dimensions = DimensionsV;
+  using UnitTuple = Private::UnitTuple<DimensionsV>;
+
+private:
+  using ThisType = MeasurementConstant<DimensionsV>;
+
+  // The measurement this constant becomes when it's used with a value of type NumT
+  template<typename NumT>
+  using As = BasicMeasurement<NumT, DimensionsV>;
+
+  // Plain numbers only hand down their type if it's floating point; 2 * 1.5_m shouldn't be an int
+  template<typename NumU>
+  using AsScalar = As<std::conditional_t<std::is_floating_point_v<NumU>, NumU, double>>;
+
+  template<typename M, typename T = int>
+  using IfConvertible = std::enable_if_t
+  <
+    Private::IdenticalDimensions<ThisType, M>::value,
+    T
+  >;
+
+  template<typename U, typename T = char>
+  using IfScalar = std::enable_if_t
+  <
+    Private::IsScalar<U>::value,
+    T
+  >;
+
+public:
+  constexpr explicit MeasurementConstant(long double value) : v(value) {}
+
+  constexpr const ValueType& value() const { return this->v; }
+
+  // With another constant, the result is still a constant
+  template<DimensionVector OtherV>
+  constexpr auto operator*(const MeasurementConstant<OtherV>& other) const
+  {
+    constexpr Rational Ratio = Private::ProductRatio<DimensionsV, OtherV>;
+    constexpr DimensionVector ResultV = DimensionsV * OtherV;
+    long double result = Private::applyRatio<long double, Ratio>(this->v * other.value());
+
+    if constexpr (ResultV.dimensionless()) return result;
+    else return MeasurementConstant<ResultV>(result);
+  }
+
+  template<DimensionVector OtherV>
+  constexpr auto operator/(const MeasurementConstant<OtherV>& other) const
+  {
+    constexpr Rational Ratio = Private::QuotientRatio<DimensionsV, OtherV>;
+    constexpr DimensionVector ResultV = DimensionsV / OtherV;
+    long double result = Private::applyRatio<long double, Ratio>(this->v / other.value());
+
+    if constexpr (ResultV.dimensionless()) return result;
+    else return MeasurementConstant<ResultV>(result);
+  }
+
+  template<DimensionVector OtherV, IfConvertible<MeasurementConstant<OtherV>> = 0>
+  constexpr ThisType operator+(const MeasurementConstant<OtherV>& other) const
+  {
+    return ThisType((As<long double>(this->v) + other).value());
+  }
+
+  template<DimensionVector OtherV, IfConvertible<MeasurementConstant<OtherV>> = 0>
+  constexpr ThisType operator-(const MeasurementConstant<OtherV>& other) const
+  {
+    return ThisType((As<long double>(this->v) - other).value());
+  }
+
+  constexpr ThisType operator-() const
+  {
+    return ThisType(-this->v);
+  }
+
+  constexpr ThisType operator+() const
+  {
+    return *this;
+  }
+
+  // With a measurement, the constant becomes a measurement with the same value type first
+  template<typename NumT, DimensionVector OtherV>
+  friend constexpr auto operator*(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) * r;
+  }
+
+  template<typename NumT, DimensionVector OtherV>
+  friend constexpr auto operator/(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) / r;
+  }
+
+  template<typename NumT, DimensionVector OtherV, IfConvertible<BasicMeasurement<NumT, OtherV>> = 0>
+  friend constexpr auto operator+(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) + r;
+  }
+
+  template<typename NumT, DimensionVector OtherV, IfConvertible<BasicMeasurement<NumT, OtherV>> = 0>
+  friend constexpr auto operator-(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) - r;
+  }
+
+  template<typename NumT, DimensionVector OtherV, IfConvertible<BasicMeasurement<NumT, OtherV>> = 0>
+  friend constexpr bool operator<(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) < r;
+  }
+
+  template<typename NumT, DimensionVector OtherV, IfConvertible<BasicMeasurement<NumT, OtherV>> = 0>
+  friend constexpr bool operator>(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) > r;
+  }
+
+  template<typename NumT, DimensionVector OtherV, IfConvertible<BasicMeasurement<NumT, OtherV>> = 0>
+  friend constexpr bool operator<=(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) <= r;
+  }
+
+  template<typename NumT, DimensionVector OtherV, IfConvertible<BasicMeasurement<NumT, OtherV>> = 0>
+  friend constexpr bool operator>=(const ThisType& l, const BasicMeasurement<NumT, OtherV>& r)
+  {
+    return As<NumT>(l) >= r;
+  }
+
+  // With a plain number, the constant becomes a measurement with the number's type
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr AsScalar<NumU> operator*(const ThisType& l, const NumU& factor)
+  {
+    return AsScalar<NumU>(l) * factor;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr AsScalar<NumU> operator*(const NumU& factor, const ThisType& r)
+  {
+    return AsScalar<NumU>(r) * factor;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr AsScalar<NumU> operator/(const ThisType& l, const NumU& divisor)
+  {
+    return AsScalar<NumU>(l) / divisor;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr auto operator/(const NumU& dividend, const ThisType& r)
+  {
+    return dividend / AsScalar<NumU>(r);
+  }
+
+private:
+  ValueType v;
+};
+
+namespace Private
+{
+
+template<DimensionVector DimensionsV>
+struct IsMeasurement<MeasurementConstant<DimensionsV>> : std::true_type {};
+
+}
+
+// How the literal operators pick their return type
+namespace LiteralModes
+{
+
+// Literals are measurements with these value types
+template<typename FloatingT, typename IntegerT>
+struct Fixed
+{
+  using Floating = FloatingT;
+  using Integer = IntegerT;
+};
+
+// Literals are MeasurementConstants, which take on the value type of whatever they're used with
+struct Adaptive {};
+
+}
+
+namespace Private
+{
+
+// Makes a literal of measurement M according to Mode
+// T is the type the literal operator got, either long double or unsigned long long int
+template<typename M, typename Mode, typename T>
+consteval auto makeLiteral(T v)
+{
+  if constexpr (std::is_same_v<Mode, LiteralModes::Adaptive>)
+  {
+    return MeasurementConstant<M::Dimensions>(static_cast<long double>(v));
+  }
+  else
+  {
+    using NumT = std::conditional_t
+    <
+      std::is_floating_point_v<T>,
+      typename Mode::Floating,
+      typename Mode::Integer
+    >;
+
+    return BasicMeasurement<NumT, M::Dimensions>(static_cast<NumT>(v));
+  }
+}
+
+}
+
+}
+
+// The literal mode used by literals in namespaces that don't declare their own
+// The literal macros look this name up without qualifying it, so declaring it in a namespace changes the mode there:
+//
+// namespace FloatLiterals
+// {
+// using MetaMeasureLiteralMode = MetaMeasure::LiteralModes::Fixed<float, int>;
+// METAMEASURE_SI_LITERALS;
+// }
+METAMEASURE_EXPORT using MetaMeasureLiteralMode = MetaMeasure::LiteralModes::Fixed
+<
+  MetaMeasure::LongDoubleLiteralResult,
+  MetaMeasure::UnsignedLongLongLiteralResult
+>;
+
+#endif
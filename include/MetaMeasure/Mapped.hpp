@@ -0,0 +1,236 @@
+#ifndef METAMEASURE_MAPPED_INCLUDED
+#define METAMEASURE_MAPPED_INCLUDED
+
+// Read-only views of files of encoded measurements (see MetaMeasure/Binary.hpp), mapped into memory
+// Nothing is read up front besides the header, so opening a file of any size is quick,
+// And the operating system only loads the pages that are actually used (and can drop them again when memory is tight).
+
+#include <MetaMeasure/Binary.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "MetaMeasure/Mapped.hpp needs mmap, which this platform doesn't have."
+#endif
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// How a mapped file is going to be read, which tells the operating system how to read ahead
+enum class MappedAccess
+{
+  // Whatever the operating system does by default
+  Normal,
+
+  // From start to end, so pages are read well ahead and dropped soon after they've been used
+  Sequential,
+
+  // All over the place, so nothing is read ahead
+  Random
+};
+
+namespace Private
+{
+
+namespace Mapped
+{
+
+inline int adviceFor(MappedAccess access)
+{
+  switch (access)
+  {
+  case MappedAccess::Sequential: return MADV_SEQUENTIAL;
+  case MappedAccess::Random: return MADV_RANDOM;
+  default: return MADV_NORMAL;
+  }
+}
+
+[[noreturn]] inline void throwSystemError(const char* what)
+{
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}
+
+}
+
+// A file of encoded measurements of type M, mapped into memory and read like a std::span<const M>
+// Opening the file checks its header, so a file of any other type, or one shorter than its header says,
+// Throws a std::invalid_argument.
+// Errors from the operating system are thrown as a std::system_error.
+template<typename M>
+class MappedMeasurements
+{
+  static_assert(Private::IsMeasurement<M>::value, "Only files of measurements can be mapped.");
+
+public:
+  using ValueType = M;
+  using Iterator = const M*;
+
+  MappedMeasurements() = default;
+
+  explicit MappedMeasurements(const char* path, MappedAccess access = MappedAccess::Normal)
+  {
+    int file = ::open(path, O_RDONLY);
+    if (file < 0) Private::Mapped::throwSystemError("MetaMeasure: couldn't open the file of measurements");
+
+    struct stat status;
+
+    if (::fstat(file, &status) != 0)
+    {
+      int error = errno;
+      ::close(file);
+      throw std::system_error(error, std::generic_category(), "MetaMeasure: couldn't read the size of the file of measurements");
+    }
+
+    if (static_cast<std::size_t>(status.st_size) < BinaryHeaderSize)
+    {
+      ::close(file);
+      throw std::invalid_argument("MetaMeasure: the file is too short to hold encoded measurements");
+    }
+
+    this->length = static_cast<std::size_t>(status.st_size);
+    void* address = ::mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping keeps the file open on its own
+    ::close(file);
+
+    if (address == MAP_FAILED)
+    {
+      this->length = 0;
+      Private::Mapped::throwSystemError("MetaMeasure: couldn't map the file of measurements");
+    }
+
+    this->mapping = static_cast<const std::byte*>(address);
+
+    try
+    {
+      this->values = MetaMeasure::view<M>(std::span<const std::byte>(this->mapping, this->length));
+    }
+    catch (...)
+    {
+      this->unmap();
+      throw;
+    }
+
+    this->advise(access);
+  }
+
+  MappedMeasurements(const MappedMeasurements&) = delete;
+  MappedMeasurements& operator=(const MappedMeasurements&) = delete;
+
+  MappedMeasurements(MappedMeasurements&& other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)),
+      length(std::exchange(other.length, 0)),
+      values(std::exchange(other.values, {}))
+  {}
+
+  MappedMeasurements& operator=(MappedMeasurements&& other) noexcept
+  {
+    if (this != &other)
+    {
+      this->unmap();
+      this->mapping = std::exchange(other.mapping, nullptr);
+      this->length = std::exchange(other.length, 0);
+      this->values = std::exchange(other.values, {});
+    }
+
+    return *this;
+  }
+
+  ~MappedMeasurements()
+  {
+    this->unmap();
+  }
+
+  std::size_t size() const { return this->values.size(); }
+  bool empty() const { return this->values.empty(); }
+
+  const M* data() const { return this->values.data(); }
+  const M& operator[](std::size_t i) const { return this->values[i]; }
+
+  Iterator begin() const { return this->values.data(); }
+  Iterator end() const { return this->values.data() + this->values.size(); }
+
+  // The measurements as a span, which stays valid for as long as this is alive
+  std::span<const M> span() const { return this->values; }
+  operator std::span<const M>() const { return this->values; }
+
+  // Tells the operating system how the whole file is going to be read
+  void advise(MappedAccess access) const
+  {
+    if (this->mapping != nullptr)
+    {
+      ::madvise(const_cast<std::byte*>(this->mapping), this->length, Private::Mapped::adviceFor(access));
+    }
+  }
+
+  // Asks the operating system to start reading count measurements from first in the background
+  void willNeed(std::size_t first, std::size_t count) const
+  {
+    this->adviseRange(first, count, MADV_WILLNEED);
+  }
+
+  // Tells the operating system that count measurements from first won't be read again soon
+  // The pages are read back from the file if they are.
+  void dontNeed(std::size_t first, std::size_t count) const
+  {
+    this->adviseRange(first, count, MADV_DONTNEED);
+  }
+
+  // Asks the CPU to start loading the cache line measurement i is in
+  // Does nothing if there's no measurement i, so the mapping is never touched past its end.
+  void prefetch(std::size_t i) const
+  {
+    if (i >= this->values.size()) return;
+
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(this->values.data() + i, 0, 0);
+#endif
+  }
+
+private:
+  const std::byte* mapping = nullptr;
+  std::size_t length = 0;
+  std::span<const M> values;
+
+  void unmap()
+  {
+    if (this->mapping != nullptr)
+    {
+      ::munmap(const_cast<std::byte*>(this->mapping), this->length);
+      this->mapping = nullptr;
+      this->length = 0;
+      this->values = {};
+    }
+  }
+
+  // madvise only takes whole pages, so the range is widened to the pages it touches
+  void adviseRange(std::size_t first, std::size_t count, int advice) const
+  {
+    if (this->mapping == nullptr || first >= this->values.size()) return;
+    if (count > this->values.size() - first) count = this->values.size() - first;
+
+    static const std::size_t PageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+    std::size_t start = BinaryHeaderSize + first * sizeof(M);
+    std::size_t end = start + count * sizeof(M);
+    start -= start % PageSize;
+
+    ::madvise(const_cast<std::byte*>(this->mapping) + start, end - start, advice);
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,387 @@
+#ifndef METAMEASURE_MATH_INCLUDED
+#define METAMEASURE_MATH_INCLUDED
+
+// Powers and roots of measurements, with their dimensions worked out at compile time
+// pow<3>(meters) is cubic meters and sqrt(square meters) is meters, in whatever units the measurement was in.
+// Whole powers are chains of multiplications and square roots are std::sqrt, so loops over them vectorize like plain loops do
+// (Square roots only with -fno-math-errno, same as std::sqrt on plain numbers).
+// Everything here is constexpr; roots are worked out with Newton's method while evaluating a constant,
+// And corrected with exact integer arithmetic so constant roots are always correctly rounded.
+// At runtime roots are the standard library's, so square roots are the same as constants,
+// But other roots can be an ulp off wherever the standard library's cbrt and pow are.
+
+#include <MetaMeasure/Measurement.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+namespace Private
+{
+
+namespace Math
+{
+
+// x to the power of N, as a chain of multiplications that squares as it goes
+template<ExponentType N, typename T>
+constexpr T power(const T& x)
+{
+  if constexpr (N < 0)
+  {
+    return T(1) / Math::power<-N>(x);
+  }
+  else if constexpr (N == 0)
+  {
+    return T(1);
+  }
+  else if constexpr (N == 1)
+  {
+    return x;
+  }
+  else
+  {
+    T half = Math::power<N / 2>(x);
+    if constexpr (N % 2 == 0) return half * half;
+    else return half * half * x;
+  }
+}
+
+// Checks if x is its own root: NaN, 0 or infinite
+// (Without x + x, which overflows and isn't a constant expression for the biggest numbers)
+template<typename T>
+constexpr bool isSpecial(T x)
+{
+  return x != x || x == 0 || x > std::numeric_limits<T>::max() || x < -std::numeric_limits<T>::max();
+}
+
+// An unsigned integer with just enough arithmetic to check a root exactly
+template<std::size_t Limbs>
+struct BigUnsigned
+{
+  std::uint32_t limbs[Limbs] = {};
+
+  static constexpr BigUnsigned from(std::uint64_t value)
+  {
+    BigUnsigned result;
+    result.limbs[0] = static_cast<std::uint32_t>(value);
+    result.limbs[1] = static_cast<std::uint32_t>(value >> 32);
+    return result;
+  }
+
+  constexpr BigUnsigned shiftedLeft(std::size_t n) const
+  {
+    BigUnsigned result;
+    std::size_t words = n / 32;
+    std::size_t bits = n % 32;
+
+    for (std::size_t i = Limbs; i-- > words;)
+    {
+      std::uint64_t value = static_cast<std::uint64_t>(this->limbs[i - words]) << bits;
+      if (bits != 0 && i > words) value |= this->limbs[i - words - 1] >> (32 - bits);
+      result.limbs[i] = static_cast<std::uint32_t>(value);
+    }
+
+    return result;
+  }
+
+  // Adds 1 or takes 1 away
+  constexpr BigUnsigned step(bool up) const
+  {
+    BigUnsigned result = *this;
+
+    for (std::uint32_t& limb : result.limbs)
+    {
+      bool carries = up ? limb == UINT32_MAX : limb == 0;
+      limb = up ? limb + 1 : limb - 1;
+      if (!carries) break;
+    }
+
+    return result;
+  }
+
+  // Only the low Limbs limbs of the product are kept
+  constexpr BigUnsigned operator*(const BigUnsigned& other) const
+  {
+    BigUnsigned result;
+
+    for (std::size_t i = 0; i < Limbs; ++i)
+    {
+      std::uint64_t carry = 0;
+
+      for (std::size_t j = 0; i + j < Limbs; ++j)
+      {
+        std::uint64_t value = static_cast<std::uint64_t>(this->limbs[i]) * other.limbs[j] + result.limbs[i + j] + carry;
+        result.limbs[i + j] = static_cast<std::uint32_t>(value);
+        carry = value >> 32;
+      }
+    }
+
+    return result;
+  }
+
+  constexpr long long bitLength() const
+  {
+    for (std::size_t i = Limbs; i-- > 0;)
+    {
+      for (int bit = 31; bit >= 0; --bit)
+      {
+        if ((this->limbs[i] >> bit) & 1) return static_cast<long long>(i * 32) + bit + 1;
+      }
+    }
+
+    return 0;
+  }
+
+  // Less than 0 if l is smaller, 0 if they're equal and more than 0 if l is bigger
+  friend constexpr int compare(const BigUnsigned& l, const BigUnsigned& r)
+  {
+    for (std::size_t i = Limbs; i-- > 0;)
+    {
+      if (l.limbs[i] != r.limbs[i]) return l.limbs[i] < r.limbs[i] ? -1 : 1;
+    }
+
+    return 0;
+  }
+};
+
+// A positive, finite floating point number as mantissa * 2^exponent, with the top bit of the mantissa set
+struct Decomposed
+{
+  std::uint64_t mantissa;
+  int exponent;
+};
+
+template<typename T>
+constexpr Decomposed decompose(T x)
+{
+  constexpr int Digits = std::numeric_limits<T>::digits;
+  int exponent = 0;
+
+  if (std::is_constant_evaluated())
+  {
+    // Multiplying and dividing by 2 is exact, so this just moves the point until x is a whole number of Digits bits
+    constexpr T Top = Math::power<Digits>(T(2));
+    while (x >= Top) { x /= 2; ++exponent; }
+    while (x < Top / 2) { x *= 2; --exponent; }
+  }
+  else
+  {
+    x = std::ldexp(std::frexp(x, &exponent), Digits);
+    exponent -= Digits;
+  }
+
+  return {static_cast<std::uint64_t>(x), exponent};
+}
+
+template<typename T>
+constexpr T compose(std::uint64_t mantissa, int exponent)
+{
+  T x = static_cast<T>(mantissa);
+  if (!std::is_constant_evaluated()) return std::ldexp(x, exponent);
+
+  for (; exponent > 0; --exponent) x *= 2;
+  for (; exponent < 0; ++exponent) x /= 2;
+  return x;
+}
+
+// Compares (m * 2^k)^N with x * 2^e exactly, like compare() does
+template<ExponentType N, typename BigT>
+constexpr int comparePower(const BigT& m, int k, const BigT& x, int e)
+{
+  BigT power = BigT::from(1);
+  for (ExponentType i = 0; i < N; ++i) power = power * m;
+
+  BigT value = x;
+  long long shift = static_cast<long long>(N) * k - e;
+
+  // Numbers with different bit lengths can be told apart without lining them up
+  long long left = power.bitLength() + shift;
+  long long right = value.bitLength();
+  if (left != right) return left < right ? -1 : 1;
+
+  if (shift > 0) power = power.shiftedLeft(static_cast<std::size_t>(shift));
+  else value = value.shiftedLeft(static_cast<std::size_t>(-shift));
+
+  return compare(power, value);
+}
+
+// Moves an Nth root of x that's a few ulps off to the correctly rounded one
+// It's right once x is between the Nth powers of the midpoints to its neighbours, which is checked with exact integers.
+template<ExponentType N, typename T>
+constexpr T correctRoot(T root, T x)
+{
+  if (Math::isSpecial(x)) return root;
+
+  if (x < 0)
+  {
+    if constexpr (N % 2 == 0) return root;
+    else return -Math::correctRoot<N>(-root, -x);
+  }
+
+  static_assert(std::numeric_limits<T>::radix == 2 && std::numeric_limits<T>::digits <= 64,
+                "Roots can only be rounded correctly for binary floating point types of up to 64 bits.");
+
+  constexpr int Digits = std::numeric_limits<T>::digits;
+  constexpr std::uint64_t TopBit = std::uint64_t(1) << (Digits - 1);
+  constexpr std::uint64_t AllBits = TopBit + (TopBit - 1);
+
+  // Big enough for the Nth power of a midpoint, which has 2 more bits than a mantissa
+  using Big = BigUnsigned<static_cast<std::size_t>(N) * (Digits + 2) / 32 + 2>;
+
+  Decomposed value = Math::decompose(x);
+  Big bigValue = Big::from(value.mantissa);
+
+  while (true)
+  {
+    Decomposed r = Math::decompose(root);
+    Big m = Big::from(r.mantissa);
+
+    if (comparePower<N>(m.shiftedLeft(1).step(true), r.exponent - 1, bigValue, value.exponent) < 0)
+    {
+      root = r.mantissa == AllBits ? Math::compose<T>(TopBit, r.exponent + 1) : Math::compose<T>(r.mantissa + 1, r.exponent);
+      continue;
+    }
+
+    // Below a power of 2, the next number down is only half as far away
+    bool bottom = r.mantissa == TopBit;
+    Big down = m.shiftedLeft(bottom ? 2 : 1).step(false);
+
+    if (comparePower<N>(down, r.exponent - (bottom ? 2 : 1), bigValue, value.exponent) > 0)
+    {
+      root = bottom ? Math::compose<T>(AllBits, r.exponent - 1) : Math::compose<T>(r.mantissa - 1, r.exponent);
+      continue;
+    }
+
+    return root;
+  }
+}
+
+// The Nth root of x with Newton's method, for when std::sqrt and friends can't be called
+template<ExponentType N, typename T>
+constexpr T newtonRoot(T x)
+{
+  if (Math::isSpecial(x)) return x;
+
+  // Odd roots of negative numbers are negative, and even ones don't exist
+  if (x < 0)
+  {
+    if constexpr (N % 2 == 0) return std::numeric_limits<T>::quiet_NaN();
+    else return -Math::newtonRoot<N>(-x);
+  }
+
+  // Starts at the power of 2 just above the root, so every step comes down toward it until it stops moving
+  // (And its powers can't overflow like x's could)
+  int bits = Math::decompose(x).exponent + std::numeric_limits<T>::digits;
+  T root = Math::compose<T>(1, bits >= 0 ? (bits + N - 1) / N : -(-bits / N));
+
+  while (true)
+  {
+    T next = ((N - 1) * root + x / Math::power<N - 1>(root)) / N;
+    if (next >= root) break;
+    root = next;
+  }
+
+  // Where it stops can be an ulp off, which would make constants different from the same roots at runtime
+  return Math::correctRoot<N>(root, x);
+}
+
+// The Nth root of x, correctly rounded when it's a constant
+// At runtime it's straight from the standard library, so loops over roots stay as fast as loops over std::cbrt.
+template<ExponentType N, typename T>
+constexpr T root(const T& x)
+{
+  if (std::is_constant_evaluated())
+  {
+    return N == 1 ? x : Math::newtonRoot<N>(x);
+  }
+
+  if constexpr (N == 1) return x;
+  else if constexpr (N == 2) return std::sqrt(x);
+  else if constexpr (N == 3) return std::cbrt(x);
+  else if constexpr (N % 2 == 0) return std::sqrt(Math::root<N / 2>(x));
+  else return std::pow(x, T(1) / N);
+}
+
+constexpr ExponentType gcd(ExponentType a, ExponentType b)
+{
+  if (a < 0) a = -a;
+
+  while (b != 0)
+  {
+    ExponentType t = a % b;
+    a = b;
+    b = t;
+  }
+
+  return a;
+}
+
+}
+
+}
+
+// Raises a measurement to the power of Num/Den, like pow<2>(meters) for square meters or pow<3, 2>(square meters)
+// The dimensions of the result have to be whole, and roots (Den > 1) need a floating point value type.
+template<ExponentType Num, ExponentType Den = 1, typename M, std::enable_if_t<Private::IsMeasurement<M>::value, int> = 0>
+constexpr auto pow(const M& measurement)
+{
+  using ValueType = typename M::ValueType;
+  constexpr DimensionVector Dimensions = M::Dimensions;
+
+  static_assert(Den > 0, "The denominator of a power has to be positive.");
+  static_assert(Dimensions.hasPower(Num, Den), "The power would leave a dimension with a fractional exponent.");
+
+  using Result = Private::MeasurementFromDimensions<ValueType, Dimensions.power(Num, Den)>;
+
+  constexpr ExponentType Divisor = Private::Math::gcd(Num, Den);
+  constexpr ExponentType N = Num / Divisor;
+  constexpr ExponentType D = Den / Divisor;
+
+  if constexpr (D == 1)
+  {
+    return Result(Private::Math::power<N>(measurement.value()));
+  }
+  else
+  {
+    static_assert(std::is_floating_point_v<ValueType>, "Only measurements with floating point values have roots.");
+    return Result(Private::Math::root<D>(Private::Math::power<N>(measurement.value())));
+  }
+}
+
+// The square root of a measurement, like sqrt(square meters) for meters
+template<typename M, std::enable_if_t<Private::IsMeasurement<M>::value, int> = 0>
+constexpr auto sqrt(const M& measurement)
+{
+  return MetaMeasure::pow<1, 2>(measurement);
+}
+
+// The cube root of a measurement, like cbrt(cubic meters) for meters
+template<typename M, std::enable_if_t<Private::IsMeasurement<M>::value, int> = 0>
+constexpr auto cbrt(const M& measurement)
+{
+  return MetaMeasure::pow<1, 3>(measurement);
+}
+
+// The length of the hypotenuse of a right triangle with sides l and r, in l's units
+// This is sqrt(l * l + r * r), so it vectorizes, but unlike std::hypot it overflows when the squares do.
+template<typename L, typename R,
+         std::enable_if_t<Private::IsMeasurement<L>::value && Private::IsMeasurement<R>::value, int> = 0>
+constexpr L hypot(const L& l, const R& r)
+{
+  static_assert(Private::IdenticalDimensions<L, R>::value, "Only measurements with the same dimensions have a hypotenuse.");
+  static_assert(std::is_floating_point_v<typename L::ValueType>, "Only measurements with floating point values have a hypotenuse.");
+
+  using ValueType = typename L::ValueType;
+  ValueType a = l.value();
+  ValueType b = L(r).value();
+  return L(Private::Math::root<2>(a * a + b * b));
+}
+
+}
+
+#endif
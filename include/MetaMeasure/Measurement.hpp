@@ -1,62 +1,115 @@
 #ifndef METAMEASURE_MEASUREMENT_INCLUDED
 #define METAMEASURE_MEASUREMENT_INCLUDED
 
-#include <MetaMeasure/Utility.hpp>
-#include <iostream>
+#include <MetaMeasure/Conversion.hpp>
 
-namespace MetaMeasure
+METAMEASURE_EXPORT namespace MetaMeasure
 {
 
-template<typename NumT, typename... Units>
-class Measurement;
+template<typename NumT, DimensionVector DimensionsV>
+class BasicMeasurement;
 
 namespace Private
 {
 
-template<typename NumT, typename Tuple>
-struct MeasurementThroughTuple_;
-
-template<typename NumT, typename... Ts>
-struct MeasurementThroughTuple_<NumT, std::tuple<Ts...>>
+// Checks if a type is a measurement
+// Anything else that acts like one (has Dimensions, UnitTuple and value()) can specialize this
+template<typename T>
+struct IsMeasurement : std::false_type {};
+
+template<typename NumT, DimensionVector DimensionsV>
+struct IsMeasurement<BasicMeasurement<NumT, DimensionsV>> : std::true_type {};
+
+// Checks if a type is an array of measurements (see MetaMeasure/Array.hpp)
+template<typename T>
+struct IsMeasurementArray : std::false_type {};
+
+// Checks if a type is an expression of measurements that hasn't been evaluated yet (see MetaMeasure/Expression.hpp)
+template<typename T>
+struct IsMeasurementExpression : std::false_type {};
+
+// Checks if a type is a measurement whose dimensions are only known at runtime (see MetaMeasure/Dynamic.hpp)
+template<typename T>
+struct IsDynamicMeasurement : std::false_type {};
+
+// Checks if a type is a measurement stored in a compact type (see MetaMeasure/Compact.hpp)
+template<typename T>
+struct IsCompactMeasurement : std::false_type {};
+
+// Checks if a type is a small vector of measurements (see MetaMeasure/Vector.hpp)
+template<typename T>
+struct IsMeasurementVector : std::false_type {};
+
+// Arrays and expressions aren't measurements, but they aren't plain numbers to multiply measurements by either
+// They bring their own operators, so measurements leave them alone
+template<typename T>
+using HasOwnOperators = std::bool_constant<IsMeasurementArray<T>::value || IsMeasurementExpression<T>::value>;
+
+// Checks if a type is a plain number, rather than a measurement of any sort
+template<typename T>
+using IsScalar = std::bool_constant
+<
+  !IsMeasurement<T>::value && !HasOwnOperators<T>::value &&
+  !IsDynamicMeasurement<T>::value && !IsCompactMeasurement<T>::value &&
+  !IsMeasurementVector<T>::value
+>;
+
+// A measurement with no dimensions is just a number
+template<typename NumT, DimensionVector DimensionsV>
+using MeasurementFromDimensions = std::conditional_t
+<
+  DimensionsV.dimensionless(),
+  NumT,
+  BasicMeasurement<NumT, DimensionsV>
+>;
+
+// The result of multiplying measurement M by measurement M2, using M's value type
+template<typename M, typename M2>
+struct Product_
 {
-  using Type = std::conditional_t
-  <
-    (sizeof...(Ts) == 0),
-    NumT,
-    Measurement<NumT, Ts...>
-  >;
+  using Type = MeasurementFromDimensions<typename M::ValueType, M::Dimensions * M2::Dimensions>;
 };
 
-template<typename NumT, typename Tuple>
-using MeasurementThroughTuple = typename MeasurementThroughTuple_<NumT, Tuple>::Type;
+// The result of dividing measurement M by measurement M2, using M's value type
+template<typename M, typename M2>
+struct Quotient_
+{
+  using Type = MeasurementFromDimensions<typename M::ValueType, M::Dimensions / M2::Dimensions>;
+};
 
 }
 
+// A measurement in the given units
+// This is only a front end; the units are lowered into a DimensionVector,
+// So listing the same units in a different order gives you the same type.
+// NumT is still deducible through this, so functions can take Measurement<T, ...> parameters.
 template<typename NumT, typename... Units>
-class Measurement
+using Measurement = BasicMeasurement<NumT, Private::dimensionsOf<Units...>()>;
+
+template<typename NumT, DimensionVector DimensionsV>
+class BasicMeasurement
 {
 public:
   using ValueType = NumT;
-  using UnitTuple = Private::RemoveZeroDimensions<std::tuple<Units...>>;
+  static constexpr DimensionVector Dimensions = DimensionsV;
 
-private:
-  using ThisType = Measurement<ValueType, Units...>;
+  // The units of this measurement, sorted by dimension (see DimensionOrder)
+  using UnitTuple = Private::UnitTuple<DimensionsV>;
 
-  // An example of something that would cause this error
-  // Would be specifying inches & meters in the parameter pack.
-  // Another example would be specifying seconds and hertz.
-  static_assert(Private::HasNoDuplicates<UnitTuple>::Value,
-                "Measurement has 2 or more units of the same dimension.");
+private:
+  using ThisType = BasicMeasurement<ValueType, DimensionsV>;
 
   using IdenticalEnabledType = int;
   using ConvertibleEnabledType = long;
   using OnlyConvertibleEnabledType = short;
+  using ScalarEnabledType = char;
+  using MeasurementEnabledType = unsigned char;
 
   // If the measurement has the same units and dimensions, overloads that use this type may be called
   template<typename M, typename T = IdenticalEnabledType>
   using IfIdentical = std::enable_if_t
   <
-    Private::IdenticalTypes<UnitTuple, typename M::UnitTuple>::value,
+    Private::IdenticalTypes<ThisType, M>::value,
     T
   >;
 
@@ -64,7 +117,7 @@ private:
   template<typename M, typename T = ConvertibleEnabledType>
   using IfConvertible = std::enable_if_t
   <
-    Private::IdenticalDimensions<UnitTuple, typename M::UnitTuple>::value,
+    Private::IdenticalDimensions<ThisType, M>::value && !Private::HasOwnOperators<M>::value,
     T
   >;
 
@@ -73,45 +126,49 @@ private:
   template<typename M, typename T = OnlyConvertibleEnabledType>
   using IfOnlyConvertible = std::enable_if_t
   <
-    (Private::IdenticalDimensions<UnitTuple, typename M::UnitTuple>::value &&
-     !Private::IdenticalTypes<UnitTuple, typename M::UnitTuple>::value),
+    (Private::IdenticalDimensions<ThisType, M>::value &&
+     !Private::IdenticalTypes<ThisType, M>::value),
     T
   >;
 
-  template<typename... Units>
-  using Product = Private::MeasurementThroughTuple
+  // If the type is a plain number rather than a measurement, overloads that use this type may be called
+  template<typename U, typename T = ScalarEnabledType>
+  using IfScalar = std::enable_if_t
   <
-    ValueType,
-    Private::MultiplyDimensions<UnitTuple, std::tuple<Units...>>
+    Private::IsScalar<U>::value,
+    T
   >;
 
-  template<typename... Units>
-  using Quotient = Private::MeasurementThroughTuple
+  // If the type is a measurement, overloads that use this type may be called
+  template<typename M, typename T = MeasurementEnabledType>
+  using IfMeasurement = std::enable_if_t
   <
-    ValueType,
-    Private::DivideDimensions<UnitTuple, std::tuple<Units...>>
+    Private::IsMeasurement<M>::value,
+    T
   >;
 
-  using Reciprocal = Private::MeasurementThroughTuple
-  <
-    ValueType,
-    Private::ReciprocalDimensions<UnitTuple>
-  >;
+  template<typename M>
+  using Product = typename Private::Product_<ThisType, M>::Type;
+
+  template<typename M>
+  using Quotient = typename Private::Quotient_<ThisType, M>::Type;
+
+  using Reciprocal = Private::MeasurementFromDimensions<ValueType, DimensionsV.reciprocal()>;
 
 public:
 
-  constexpr Measurement() = default;
-  constexpr Measurement(NumT value) : v(value) {}
+  constexpr BasicMeasurement() = default;
+  constexpr BasicMeasurement(NumT value) : v(value) {}
 
   template<typename M, IfIdentical<M> = 0>
-  constexpr Measurement(const M& other)
+  constexpr BasicMeasurement(const M& other)
     : v(ThisType::valueOf(other))
   {}
 
   // If you error at this constructor,
   // Chances are you tried to copy construct from a measurement without identical dimensions.
   template<typename M, IfOnlyConvertible<M> = 0>
-  constexpr Measurement(const M& other)
+  constexpr BasicMeasurement(const M& other)
     : v(ThisType::convertedValueOf(other))
   {}
 
@@ -119,79 +176,92 @@ public:
 
   // Arithmetic operators
   template<typename M, IfConvertible<M> = 0>
-  constexpr ThisType operator+(const M& other)
+  constexpr ThisType operator+(const M& other) const
   {
     return this->v + ThisType::convertedValueOf(other);
   }
 
   template<typename M, IfConvertible<M> = 0>
-  constexpr ThisType operator-(const M& other)
+  constexpr ThisType operator-(const M& other) const
   {
     return this->v - ThisType::convertedValueOf(other);
   }
 
-  template<typename NumU, typename... UnitsU>
-  constexpr Product<UnitsU...> operator*(const Measurement<NumU, UnitsU...>& other)
+  // The result keeps this measurement's units for any dimension both measurements have
+  // The other measurement's value gets scaled to match them
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr auto operator*(const M& other) const
   {
-    using M = Measurement<NumU, UnitsU...>;
-    using ConversionRatio = Private::ConversionRatio<UnitTuple, typename M::UnitTuple>;
-    return (this->v * ThisType::valueOf(other)) * ConversionRatio::num / ConversionRatio::den;
+    using Result = Product<M>;
+    constexpr Rational Ratio = Private::ProductRatio<DimensionsV, M::Dimensions>;
+
+    // Integers are multiplied in WideInteger, so the product is only narrowed once it's been scaled
+    if constexpr (std::is_integral_v<ValueType> && Ratio != Rational())
+    {
+      Private::WideInteger product = static_cast<Private::WideInteger>(this->v) * ThisType::valueOf(other);
+      return Result(Private::scaleInteger<ValueType, Ratio, Rounding::Truncate, Overflow::Unchecked>(product));
+    }
+    else
+    {
+      return Result(Private::applyRatio<ValueType, Ratio>(this->v * ThisType::valueOf(other)));
+    }
   }
 
-  template<typename NumU, typename... UnitsU>
-  constexpr Quotient<UnitsU...> operator/(const Measurement<NumU, UnitsU...>& other)
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr auto operator/(const M& other) const
   {
-    using M = Measurement<NumU, UnitsU...>;
-    using ConversionRatio = Private::ConversionRatio<UnitTuple, typename M::UnitTuple>;
-    return (this->v * ConversionRatio::den)  / (ThisType::valueOf(other) * ConversionRatio::num);
+    using Result = Quotient<M>;
+    constexpr Rational Ratio = Private::QuotientRatio<DimensionsV, M::Dimensions>;
+
+    // Integers are scaled before dividing, so less is lost to truncation
+    // Both sides are scaled in WideInteger, and the quotient is narrowed like a conversion (see Private::scaleInteger).
+    if constexpr (std::is_integral_v<ValueType> && Ratio != Rational())
+    {
+      Private::WideInteger dividend = static_cast<Private::WideInteger>(this->v) * Ratio.num;
+      Private::WideInteger divisor = static_cast<Private::WideInteger>(ThisType::valueOf(other)) * Ratio.den;
+      return Result(Private::divideInteger<ValueType, Rounding::Truncate, Overflow::Unchecked>(dividend, divisor));
+    }
+    else
+    {
+      return Result(Private::applyRatio<ValueType, Ratio>(this->v / ThisType::valueOf(other)));
+    }
   }
 
-  template<typename NumU>
-  constexpr ThisType operator*(const NumU& factor)
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType operator*(const NumU& factor) const
   {
     return this->v * factor;
   }
 
-  template<typename NumU>
+  template<typename NumU, IfScalar<NumU> = 0>
   friend constexpr ThisType operator*(const NumU& factor, const ThisType& r)
   {
     return r.v * factor;
   }
 
-  template<typename NumU>
-  constexpr ThisType operator/(const NumU& divisor)
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType operator/(const NumU& divisor) const
   {
     return this->v / divisor;
   }
 
-  template<typename NumU>
+  template<typename NumU, IfScalar<NumU> = 0>
   friend constexpr Reciprocal operator/(const NumU& dividend, const ThisType& divisor)
   {
     return dividend / divisor.v;
   }
 
-  constexpr ThisType operator-()
+  constexpr ThisType operator-() const
   {
     return -this->v;
   }
 
-  constexpr ThisType operator+()
+  constexpr ThisType operator+() const
   {
     return +this->v;
   }
 
   // Assignment operators
-  /*template<typename NumU>
-  constexpr ThisType& operator=(const NumU& newValue)
-  {
-#ifdef METAMEASURE_SUPPRESS_CONVERSION_WARNINGS
-    this->v = static_cast<ValueType>(newValue);
-#else
-    this->v = newValue;
-#endif
-    return *this;
-  }*/
-
   template<typename M, IfConvertible<M> = 0>
   constexpr ThisType& operator=(const M& other)
   {
@@ -213,55 +283,49 @@ public:
     return *this;
   }
 
-  template<typename NumU>
+  template<typename NumU, IfScalar<NumU> = 0>
   constexpr ThisType& operator*=(const NumU& factor)
   {
     this->v *= factor;
     return *this;
   }
 
-  template<typename NumU>
-  constexpr ThisType& operator/=(const NumU& factor)
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType& operator/=(const NumU& divisor)
   {
-    this->v *= factor;
+    this->v /= divisor;
     return *this;
   }
 
   // Comparison operators
   template<typename M, IfConvertible<M> = 0>
-  constexpr bool operator<(const M& other)
+  constexpr bool operator<(const M& other) const
   {
     return this->v < ThisType::convertedValueOf(other);
   }
 
   template<typename M, IfConvertible<M> = 0>
-  constexpr bool operator>(const M& other)
+  constexpr bool operator>(const M& other) const
   {
     return this->v > ThisType::convertedValueOf(other);
   }
 
   template<typename M, IfConvertible<M> = 0>
-  constexpr bool operator<=(const M& other)
+  constexpr bool operator<=(const M& other) const
   {
     return this->v <= ThisType::convertedValueOf(other);
   }
 
   template<typename M, IfConvertible<M> = 0>
-  constexpr bool operator>=(const M& other)
+  constexpr bool operator>=(const M& other) const
   {
     return this->v >= ThisType::convertedValueOf(other);
   }
 
   template<typename M, IfConvertible<M> = 0>
-  constexpr bool operator==(const M& other)
-  {
-    return this->v < ThisType::valueOf(other);
-  }
-
-  template<typename M, IfConvertible<M> = 0>
-  constexpr bool operator!=(const M& other)
+  constexpr bool operator==(const M& other) const
   {
-    return this->v < ThisType::valueOf(other);
+    return this->v == ThisType::convertedValueOf(other);
   }
 
 private:
@@ -281,11 +345,41 @@ private:
   template<typename M>
   static constexpr ValueType convertedValueOf(const M& other)
   {
-    using ConversionRatio = Private::ConversionRatio<UnitTuple, typename M::UnitTuple>;
-    return ThisType::valueOf(other)*ConversionRatio::num / ConversionRatio::den;
+    return Private::applyRatio<ValueType, Private::ConversionRatio<M::Dimensions, Dimensions>>(ThisType::valueOf(other));
   }
 };
 
+// Converts a measurement into measurement To, which has to have the same dimensions
+// When both value types are integers, the conversion is exact up to the final rounding,
+// Which RoundingT picks (see Rounding), and OverflowT picks what happens if the result doesn't fit (see Overflow).
+// Floating point values converted into integers are scaled first, then rounded and narrowed with the same policies.
+// Otherwise, this is the same as constructing a To from the measurement.
+template<typename To, typename RoundingT = Rounding::Truncate, typename OverflowT = Overflow::Unchecked, typename From>
+constexpr To convert(const From& from)
+{
+  static_assert(Private::IdenticalDimensions<To, From>::value,
+                "Measurements can only be converted into measurements with the same dimensions.");
+
+  using ToT = typename To::ValueType;
+  using FromT = typename From::ValueType;
+  constexpr Rational Ratio = Private::ConversionRatio<From::Dimensions, To::Dimensions>;
+
+  if constexpr (std::is_integral_v<ToT> && std::is_integral_v<FromT>)
+  {
+    return To(Private::scaleInteger<ToT, Ratio, RoundingT, OverflowT>(from.value()));
+  }
+  else if constexpr (std::is_integral_v<ToT> && std::is_floating_point_v<FromT>)
+  {
+    // Scaled in FromT so nothing is cut off before it's rounded, like batch conversions do
+    FromT scaled = Private::applyRatio<FromT, Ratio>(from.value());
+    return To(Private::narrowRounded<ToT, OverflowT>(Private::round<RoundingT>(scaled)));
+  }
+  else
+  {
+    return To(Private::applyRatio<ToT, Ratio>(static_cast<ToT>(from.value())));
+  }
+}
+
 }
 
 #endif
@@ -0,0 +1,602 @@
+#ifndef METAMEASURE_PARSE_INCLUDED
+#define METAMEASURE_PARSE_INCLUDED
+
+// Reading measurements from text, like "3 ft" or "9.81 m/s^2"
+// Unit symbols are the suffixes of the literals MetaMeasure.hpp defines, without their underscore (see MetaMeasure/Symbols.hpp),
+// And they're looked up in a perfect hash table that's built at compile time.
+// Numbers are read with std::from_chars, so nothing here allocates or depends on the locale.
+
+#include <MetaMeasure/Symbols.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// Why text couldn't be parsed into a measurement
+enum class ParseError
+{
+  None,
+
+  // There's no number where the measurement should start
+  InvalidNumber,
+
+  // The number doesn't fit in the measurement's value type
+  OutOfRange,
+
+  // A unit symbol isn't known, or the units aren't written as symbols joined by *, / and ^
+  UnknownUnit,
+
+  // The units don't measure the same thing as the measurement being parsed
+  WrongDimensions,
+
+  // There's something other than blanks after the measurement
+  TrailingCharacters
+};
+
+// Where parsing stopped and what went wrong, like std::from_chars_result
+// On an error, ptr points at the part of the text that couldn't be parsed.
+struct ParseResult
+{
+  const char* ptr;
+  ParseError error;
+};
+
+// What parsing a buffer of measurements did
+// count is how many measurements were written, and ptr is where parsing stopped.
+struct BulkParseResult
+{
+  std::size_t count;
+  const char* ptr;
+  ParseError error;
+};
+
+namespace Private
+{
+
+namespace Parsing
+{
+
+// A perfect hash table from keys to indices into Symbols::AllSymbols
+// A key's slot is the top bits of key * multiplier, with the multiplier picked at compile time so no 2 symbols share a slot.
+// Looking a symbol up is then a multiply, a shift, a byte load and a comparison.
+struct SymbolTable
+{
+  static constexpr unsigned SlotBits = 12;
+  static constexpr std::size_t SlotCount = std::size_t(1) << SlotBits;
+  static constexpr unsigned char Empty = 255;
+
+  std::uint64_t multiplier = 0;
+  unsigned char slots[SlotCount] = {};
+
+  constexpr std::size_t slotOf(std::uint64_t key) const
+  {
+    return static_cast<std::size_t>((key * this->multiplier) >> (64 - SlotBits));
+  }
+
+  constexpr const Symbols::Symbol* find(std::uint64_t key) const
+  {
+    unsigned char i = this->slots[this->slotOf(key)];
+    if (i == Empty || Symbols::AllSymbols[i].key != key) return nullptr;
+    return &Symbols::AllSymbols[i];
+  }
+};
+
+// Tries odd multipliers until one puts every symbol in its own slot
+// When 2 literals have the same suffix, the first one gets the slot,
+// Which makes "nm" nanometers rather than nautical miles, as SI literals come first.
+consteval SymbolTable hashSymbols()
+{
+  static_assert(Symbols::AllSymbols.size() < SymbolTable::Empty, "There are too many unit symbols for the table.");
+
+  for (std::uint64_t multiplier = 0x9E3779B97F4A7C15; ; multiplier += 0x5851F42D4C957F2E)
+  {
+    SymbolTable table;
+    table.multiplier = multiplier;
+    for (unsigned char& slot : table.slots) slot = SymbolTable::Empty;
+
+    bool collided = false;
+
+    for (std::size_t i = 0; i < Symbols::AllSymbols.size() && !collided; ++i)
+    {
+      unsigned char& slot = table.slots[table.slotOf(Symbols::AllSymbols[i].key)];
+
+      if (slot == SymbolTable::Empty) slot = static_cast<unsigned char>(i);
+      else collided = Symbols::AllSymbols[slot].key != Symbols::AllSymbols[i].key;
+    }
+
+    if (!collided) return table;
+  }
+}
+
+inline constexpr SymbolTable Table = Parsing::hashSymbols();
+
+constexpr const Symbols::Symbol* findSymbol(const char* symbol, std::size_t length)
+{
+  if (length > Symbols::MaxSymbolLength) return nullptr;
+  return Table.find(Symbols::keyOf(symbol, length));
+}
+
+constexpr bool isLetter(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+constexpr bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Characters that can be part of a unit, like "kg*m/s^-2"
+constexpr bool isUnitCharacter(char c)
+{
+  return Parsing::isLetter(c) || (c >= '0' && c <= '9') || c == '^' || c == '-' || c == '*' || c == '/';
+}
+
+// A ratio that's kept exact for as long as it fits in 64 bits
+// Whole numbers going into integer measurements are scaled by this instead of a floating point factor.
+struct ExactRatio
+{
+  Rational ratio = {};
+  bool exact = true;
+
+  // The numerator of a ratio a 64-bit value can be scaled by without overflowing a WideInteger
+  // That's only 1 when WideInteger is no wider than 64 bits.
+  static constexpr WideInteger MaxScale = sizeof(WideInteger) > sizeof(std::intmax_t) ? std::numeric_limits<std::intmax_t>::max() : 1;
+
+  // Multiplies by r, or stops being exact if the result wouldn't fit
+  constexpr void multiply(const Rational& r)
+  {
+    constexpr WideInteger Max = std::numeric_limits<std::intmax_t>::max();
+
+    if (!this->exact || r.num <= 0 || r.den <= 0)
+    {
+      this->exact = false;
+      return;
+    }
+
+    // Cross reduced first, like Rational's operator*
+    WideInteger a = Private::gcd(this->ratio.num, r.den);
+    WideInteger b = Private::gcd(r.num, this->ratio.den);
+    WideInteger num = this->ratio.num / a;
+    WideInteger den = this->ratio.den / b;
+    WideInteger rNum = r.num / b;
+    WideInteger rDen = r.den / a;
+
+    if (num > Max / rNum || den > Max / rDen)
+    {
+      this->exact = false;
+      return;
+    }
+
+    this->ratio = Rational(num * rNum, den * rDen);
+  }
+
+  // Checks if a 64-bit value can be scaled by this exactly
+  constexpr bool scales() const
+  {
+    return this->exact && this->ratio.num <= MaxScale;
+  }
+};
+
+// Units written as text, boiled down to base units
+struct ParsedUnit
+{
+  ExponentType exponents[DimensionCount] = {0, 0, 0, 0, 0, 0, 0};
+
+  // How many base units 1 of this unit is
+  long double factor = 1;
+
+  // The same as an exact ratio, when there is one
+  ExactRatio exactFactor;
+};
+
+// Checks if a number that was read as an integer goes on past p, as a fraction or an exponent like "2.5" or "1e3"
+constexpr bool continuesNumber(const char* p, const char* last)
+{
+  if (p == last) return false;
+  if (*p == '.') return true;
+  if (*p != 'e' && *p != 'E') return false;
+
+  ++p;
+  if (p != last && (*p == '+' || *p == '-')) ++p;
+  return p != last && *p >= '0' && *p <= '9';
+}
+
+// Reads a number in a unit's multiple, keeping it exact if it's whole
+inline std::from_chars_result parseMultipleNumber(const char* first, const char* last, long double& value, ExactRatio& exact,
+                                                  bool denominator)
+{
+  std::intmax_t whole;
+  std::from_chars_result result = std::from_chars(first, last, whole);
+
+  if (result.ec == std::errc() && !Parsing::continuesNumber(result.ptr, last))
+  {
+    value = static_cast<long double>(whole);
+    exact.multiply(denominator ? Rational(1, whole) : Rational(whole));
+    return result;
+  }
+
+  exact.exact = false;
+  return std::from_chars(first, last, value, std::chars_format::fixed);
+}
+
+// Anything bigger than this is a typo
+inline constexpr int MaxUnitExponent = 64;
+
+// One unit in a product: a symbol, or a multiple of one in parentheses like "(127/5000 m)" for inches
+// That's how MetaMeasure/Format.hpp writes units that don't have a symbol of their own.
+inline ParseResult parseTerm(const char* first, const char* last, const Symbols::Symbol*& symbol, long double& multiple,
+                             ExactRatio& exactMultiple)
+{
+  const char* p = first;
+  bool parenthesized = p != last && *p == '(';
+  multiple = 1;
+  exactMultiple = ExactRatio();
+
+  if (parenthesized)
+  {
+    long double num = 1;
+    long double den = 1;
+
+    std::from_chars_result result = Parsing::parseMultipleNumber(p + 1, last, num, exactMultiple, false);
+    if (result.ec != std::errc()) return {p, ParseError::UnknownUnit};
+    p = result.ptr;
+
+    if (p != last && *p == '/')
+    {
+      result = Parsing::parseMultipleNumber(p + 1, last, den, exactMultiple, true);
+      if (result.ec != std::errc() || den == 0) return {p, ParseError::UnknownUnit};
+      p = result.ptr;
+    }
+
+    if (p == last || *p != ' ') return {p, ParseError::UnknownUnit};
+    ++p;
+
+    multiple = num / den;
+  }
+
+  const char* symbolStart = p;
+  while (p != last && Parsing::isLetter(*p)) ++p;
+
+  symbol = Parsing::findSymbol(symbolStart, static_cast<std::size_t>(p - symbolStart));
+  if (symbol == nullptr) return {symbolStart, ParseError::UnknownUnit};
+
+  if (parenthesized)
+  {
+    if (p == last || *p != ')') return {p, ParseError::UnknownUnit};
+    ++p;
+  }
+
+  return {p, ParseError::None};
+}
+
+// Parses units joined by * and /, each with an optional ^exponent
+// Operators are applied left to right, so "kg*m/s^2" is (kg * m) / s^2 and "m/s/s" is m / s^2.
+inline ParseResult parseUnit(const char* first, const char* last, ParsedUnit& unit)
+{
+  const char* p = first;
+  bool divide = false;
+
+  while (true)
+  {
+    const Symbols::Symbol* symbol;
+    long double multiple;
+    ExactRatio exactMultiple;
+
+    ParseResult term = Parsing::parseTerm(p, last, symbol, multiple, exactMultiple);
+    if (term.error != ParseError::None) return term;
+    p = term.ptr;
+
+    int exponent = 1;
+
+    if (p != last && *p == '^')
+    {
+      std::from_chars_result result = std::from_chars(p + 1, last, exponent);
+
+      if (result.ec != std::errc() || exponent < -MaxUnitExponent || exponent > MaxUnitExponent)
+      {
+        return {p, ParseError::UnknownUnit};
+      }
+
+      p = result.ptr;
+    }
+
+    if (divide) exponent = -exponent;
+
+    for (std::size_t i = 0; i < DimensionCount; ++i)
+    {
+      unit.exponents[i] += symbol->exponents[i] * exponent;
+    }
+
+    long double factor = symbol->factor * multiple;
+    for (int i = 0; i < exponent; ++i) unit.factor *= factor;
+    for (int i = 0; i > exponent; --i) unit.factor /= factor;
+
+    // A symbol's ratio is how many of it fit in a base unit, so the factor is its reciprocal
+    exactMultiple.multiply(Rational(symbol->ratio.den, symbol->ratio.num));
+    if (!exactMultiple.exact) unit.exactFactor.exact = false;
+
+    for (int i = 0; i < exponent && unit.exactFactor.exact; ++i) unit.exactFactor.multiply(exactMultiple.ratio);
+    for (int i = 0; i > exponent && unit.exactFactor.exact; --i)
+    {
+      unit.exactFactor.multiply(Rational(exactMultiple.ratio.den, exactMultiple.ratio.num));
+    }
+
+    if (p == last || (*p != '*' && *p != '/')) return {p, ParseError::None};
+
+    divide = *p == '/';
+    ++p;
+  }
+}
+
+// Where the text of a unit starting at p ends
+// Blanks are only part of it inside parentheses, like "(127/5000 m)".
+inline const char* unitEnd(const char* p, const char* last)
+{
+  int depth = 0;
+
+  while (p != last)
+  {
+    char c = *p;
+
+    if (c == '(') ++depth;
+    else if (c == ')' && depth > 0) --depth;
+    else if (!Parsing::isUnitCharacter(c) && !(c == ' ' && depth > 0)) break;
+
+    ++p;
+  }
+
+  return p;
+}
+
+// The last unit that was parsed, and what it takes to convert it into To
+// Measurements in a buffer are usually all in the same units, so most of them skip looking up symbols.
+template<typename To>
+struct UnitCache
+{
+  // long double measurements are worked out in long double, everything else in double
+  using ComputeT = std::conditional_t<std::is_same_v<typename To::ValueType, long double>, long double, double>;
+
+  static constexpr std::size_t Capacity = 32;
+
+  char text[Capacity] = {};
+  std::size_t length = Capacity + 1;
+  ComputeT factor = 1;
+
+  // The same factor as an exact ratio, for whole numbers going into integer measurements
+  ExactRatio exactFactor;
+};
+
+// Turns a whole number in some units into a To, scaling it by the exact ratio to To's units
+// It's rounded like integer conversions are (see Private::scaleInteger), so integers past 2^53 aren't rounded by a double first.
+template<typename To, typename RoundingT>
+inline ParseError makeWholeMeasurement(typename To::ValueType value, const Rational& ratio, To& out)
+{
+  using ValueType = typename To::ValueType;
+
+  WideInteger product = static_cast<WideInteger>(value) * ratio.num;
+  WideInteger scaled = Private::roundQuotient<RoundingT>(product / ratio.den, product % ratio.den, ratio.den);
+
+  if (scaled < static_cast<WideInteger>(std::numeric_limits<ValueType>::min()) ||
+      scaled > static_cast<WideInteger>(std::numeric_limits<ValueType>::max()))
+  {
+    return ParseError::OutOfRange;
+  }
+
+  out = To(static_cast<ValueType>(scaled));
+  return ParseError::None;
+}
+
+// Turns a number in To's units into a To, rounding it if To holds integers
+template<typename To, typename RoundingT, typename ComputeT>
+inline ParseError makeMeasurement(ComputeT value, To& out)
+{
+  using ValueType = typename To::ValueType;
+
+  if constexpr (std::is_integral_v<ValueType>)
+  {
+    ComputeT rounded = Private::round<RoundingT>(value);
+
+    // max() + 1 is a power of 2, so it's exact in ComputeT; NaN fails both comparisons
+    if (!(rounded >= static_cast<ComputeT>(std::numeric_limits<ValueType>::min()) &&
+          rounded < static_cast<ComputeT>(std::numeric_limits<ValueType>::max()) + 1))
+    {
+      return ParseError::OutOfRange;
+    }
+
+    out = To(static_cast<ValueType>(rounded));
+  }
+  else
+  {
+    out = To(static_cast<ValueType>(value));
+  }
+
+  return ParseError::None;
+}
+
+template<typename To, typename RoundingT>
+inline ParseResult parseMeasurement(const char* first, const char* last, To& out, UnitCache<To>& cache)
+{
+  using ComputeT = typename UnitCache<To>::ComputeT;
+  using ValueType = typename To::ValueType;
+
+  const char* p = first;
+  while (p != last && Parsing::isBlank(*p)) ++p;
+  if (p != last && *p == '+') ++p;
+
+  ComputeT number = 0;
+
+  // Whole numbers going into integer measurements are read as integers, so they can be scaled exactly
+  // Anything else (and whole numbers that don't fit in the value type) is read as a floating point number.
+  ValueType whole = 0;
+  bool isWhole = false;
+
+  if constexpr (std::is_integral_v<ValueType>)
+  {
+    std::from_chars_result wholeResult = std::from_chars(p, last, whole);
+    isWhole = wholeResult.ec == std::errc() && !Parsing::continuesNumber(wholeResult.ptr, last);
+    if (isWhole) p = wholeResult.ptr;
+  }
+
+  if (!isWhole)
+  {
+    std::from_chars_result numberResult = std::from_chars(p, last, number);
+
+    if (numberResult.ec == std::errc::invalid_argument) return {first, ParseError::InvalidNumber};
+    if (numberResult.ec == std::errc::result_out_of_range) return {p, ParseError::OutOfRange};
+
+    p = numberResult.ptr;
+  }
+
+  while (p != last && Parsing::isBlank(*p)) ++p;
+
+  const char* unitStart = p;
+  p = Parsing::unitEnd(p, last);
+
+  std::string_view unitText(unitStart, static_cast<std::size_t>(p - unitStart));
+
+  bool cached = cache.length <= UnitCache<To>::Capacity && unitText == std::string_view(cache.text, cache.length);
+
+  if (!cached)
+  {
+    ParsedUnit unit;
+
+    if (!unitText.empty())
+    {
+      ParseResult result = Parsing::parseUnit(unitStart, p, unit);
+      if (result.error != ParseError::None) return result;
+      if (result.ptr != p) return {result.ptr, ParseError::UnknownUnit};
+    }
+
+    for (std::size_t i = 0; i < DimensionCount; ++i)
+    {
+      if (unit.exponents[i] != To::Dimensions.exponents[i]) return {unitStart, ParseError::WrongDimensions};
+    }
+
+    cache.factor = static_cast<ComputeT>(unit.factor * Symbols::toLongDouble(To::Dimensions.ratio));
+    cache.exactFactor = unit.exactFactor;
+    cache.exactFactor.multiply(To::Dimensions.ratio);
+    cache.length = unitText.size() <= UnitCache<To>::Capacity ? unitText.size() : UnitCache<To>::Capacity + 1;
+    if (cache.length == unitText.size()) std::memcpy(cache.text, unitText.data(), unitText.size());
+  }
+
+  ParseError error;
+
+  if (isWhole && cache.exactFactor.scales())
+  {
+    error = Parsing::makeWholeMeasurement<To, RoundingT>(whole, cache.exactFactor.ratio, out);
+  }
+  else
+  {
+    if (isWhole) number = static_cast<ComputeT>(whole);
+    error = Parsing::makeMeasurement<To, RoundingT>(number * cache.factor, out);
+  }
+
+  if (error != ParseError::None) return {first, error};
+
+  return {p, ParseError::None};
+}
+
+inline const char* describe(ParseError error)
+{
+  switch (error)
+  {
+  case ParseError::InvalidNumber: return "MetaMeasure: the text doesn't start with a number";
+  case ParseError::OutOfRange: return "MetaMeasure: the number doesn't fit in the measurement's value type";
+  case ParseError::UnknownUnit: return "MetaMeasure: the units aren't known";
+  case ParseError::WrongDimensions: return "MetaMeasure: the units don't measure the same thing as the measurement";
+  case ParseError::TrailingCharacters: return "MetaMeasure: there's more text after the measurement";
+  default: return "MetaMeasure: the measurement was parsed";
+  }
+}
+
+}
+
+}
+
+// Parses a measurement at the start of [first, last) and converts it into To
+// Blanks may come before the number and between it and its units,
+// And integer measurements are rounded with RoundingT (see Rounding).
+// Like std::from_chars, this stops at the first character that isn't part of the measurement and never throws.
+template<typename To, typename RoundingT = Rounding::Truncate>
+inline ParseResult fromChars(const char* first, const char* last, To& out)
+{
+  static_assert(Private::IsMeasurement<To>::value, "Text can only be parsed into a measurement.");
+
+  Private::Parsing::UnitCache<To> cache;
+  return Private::Parsing::parseMeasurement<To, RoundingT>(first, last, out, cache);
+}
+
+// Parses text that's nothing but a measurement (and maybe blanks) and converts it into To
+// Throws a std::invalid_argument when the text isn't a measurement with the right dimensions.
+template<typename To, typename RoundingT = Rounding::Truncate>
+inline To parse(std::string_view text)
+{
+  To result;
+  const char* last = text.data() + text.size();
+  ParseResult parsed = MetaMeasure::fromChars<To, RoundingT>(text.data(), last, result);
+
+  while (parsed.error == ParseError::None && parsed.ptr != last)
+  {
+    if (!Private::Parsing::isBlank(*parsed.ptr)) parsed.error = ParseError::TrailingCharacters;
+    else ++parsed.ptr;
+  }
+
+  if (parsed.error != ParseError::None)
+  {
+    throw std::invalid_argument(Private::Parsing::describe(parsed.error));
+  }
+
+  return result;
+}
+
+// Parses 1 measurement per line into out, skipping blank lines and taking "\r\n" line endings too
+// This stops when out is full, at the end of the text, or at the first line that isn't a measurement.
+// So a buffer that's bigger than out can be parsed a span at a time, by starting again at ptr.
+template<typename To, typename RoundingT = Rounding::Truncate, std::size_t Extent>
+inline BulkParseResult parseLines(std::string_view text, std::span<To, Extent> out)
+{
+  static_assert(Private::IsMeasurement<To>::value, "Text can only be parsed into a measurement.");
+
+  Private::Parsing::UnitCache<To> cache;
+
+  const char* p = text.data();
+  const char* end = p + text.size();
+  std::size_t count = 0;
+
+  while (p != end && count < out.size())
+  {
+    const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+    if (lineEnd == nullptr) lineEnd = end;
+    const char* next = lineEnd == end ? end : lineEnd + 1;
+
+    while (p != lineEnd && Private::Parsing::isBlank(*p)) ++p;
+    while (lineEnd != p && Private::Parsing::isBlank(lineEnd[-1])) --lineEnd;
+
+    if (p != lineEnd)
+    {
+      ParseResult parsed = Private::Parsing::parseMeasurement<To, RoundingT>(p, lineEnd, out[count], cache);
+      if (parsed.error != ParseError::None) return {count, parsed.ptr, parsed.error};
+      if (parsed.ptr != lineEnd) return {count, parsed.ptr, ParseError::TrailingCharacters};
+      ++count;
+    }
+
+    p = next;
+  }
+
+  return {count, p, ParseError::None};
+}
+
+}
+
+#endif
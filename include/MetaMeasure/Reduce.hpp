@@ -0,0 +1,398 @@
+#ifndef METAMEASURE_REDUCE_INCLUDED
+#define METAMEASURE_REDUCE_INCLUDED
+
+// Reductions over spans of measurements: sum, mean, min, max, dot and norm
+// How they run is picked with an Execution policy, and how sums are added up with a Summation policy.
+// Sums are added up in the measurements' value type, so compensated summation is what keeps long sums of floats accurate.
+// Compensated summation relies on the compiler not reassociating floating point math, so don't build it with -ffast-math.
+
+#include <MetaMeasure/Measurement.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// Where and how a reduction runs
+namespace Execution
+{
+
+// 1 running total, in order, on the calling thread
+struct Sequential {};
+
+// Several independent running totals on the calling thread, so the compiler can keep them in 1 vector register
+struct Simd {};
+
+// Each thread reduces an equal share of the span like Simd does, and their results are combined in order
+// threads is how many threads to use, or 0 for as many as the hardware has.
+// The result can change in the last bits with the number of threads, since that changes where the shares are cut.
+struct Parallel
+{
+  unsigned threads = 0;
+};
+
+// Like Parallel, but the span is always cut into the same fixed-size chunks, whatever the number of threads
+// So the result is the same to the bit on any number of threads (built with the same compiler and flags).
+struct Deterministic
+{
+  unsigned threads = 0;
+};
+
+}
+
+// How the terms of a sum are added up
+namespace Summation
+{
+
+// Added 1 at a time, which loses precision as the total gets bigger than the terms
+struct Naive {};
+
+// Added 1 at a time while carrying what's rounded off into the next term (Kahan summation)
+// Accurate whatever the number of terms, for 4 times the additions.
+struct Kahan {};
+
+// Added in pairs, then pairs of pairs and so on, so the error only grows with the log of the number of terms
+// Nearly as fast as Naive.
+struct Pairwise {};
+
+}
+
+namespace Private
+{
+
+namespace Reduce
+{
+
+// How many running totals Simd and the parallel policies keep
+// It's fixed rather than picked for the CPU, so results don't change with the instruction set.
+inline constexpr std::size_t Lanes = 8;
+
+// How many terms Pairwise adds up 1 at a time before it stops splitting them
+inline constexpr std::size_t PairwiseBlock = 128;
+
+// The size of the chunks Deterministic cuts spans into
+inline constexpr std::size_t ChunkSize = std::size_t(1) << 14;
+
+// Spans shorter than this per thread aren't worth starting threads for
+inline constexpr std::size_t MinThreadShare = std::size_t(1) << 15;
+
+template<typename ExecT>
+inline constexpr std::size_t LanesOf = std::is_same_v<ExecT, Execution::Sequential> ? 1 : Lanes;
+
+template<typename ExecT>
+inline constexpr bool IsParallel = std::is_same_v<ExecT, Execution::Parallel> || std::is_same_v<ExecT, Execution::Deterministic>;
+
+// A running total
+template<typename T>
+struct NaiveTotal
+{
+  T sum = 0;
+
+  void add(T term) { this->sum += term; }
+  void merge(const NaiveTotal& other) { this->sum += other.sum; }
+  T result() const { return this->sum; }
+};
+
+// A running total and what was rounded off the last time it was added to
+// Taking that off the next term carries it along, so it's never lost like it would be in a separate total.
+template<typename T>
+struct KahanTotal
+{
+  T sum = 0;
+
+  // What the sum has that it shouldn't, so sum - compensation is the exact total
+  T compensation = 0;
+
+  void add(T term)
+  {
+    T corrected = term - this->compensation;
+    T total = this->sum + corrected;
+    this->compensation = (total - this->sum) - corrected;
+    this->sum = total;
+  }
+
+  void merge(const KahanTotal& other)
+  {
+    this->add(other.sum);
+    this->add(-other.compensation);
+  }
+
+  T result() const { return this->sum - this->compensation; }
+};
+
+template<typename T, typename SumT>
+using Total = std::conditional_t<std::is_same_v<SumT, Summation::Kahan>, KahanTotal<T>, NaiveTotal<T>>;
+
+// Adds up term(i) for i in [first, last) into LanesV running totals, then combines them in order
+template<typename TotalT, std::size_t LanesV, typename Term>
+inline TotalT addTerms(std::size_t first, std::size_t last, const Term& term)
+{
+  TotalT lanes[LanesV] = {};
+  std::size_t i = first;
+
+  for (; i + LanesV <= last; i += LanesV)
+  {
+    for (std::size_t lane = 0; lane < LanesV; ++lane) lanes[lane].add(term(i + lane));
+  }
+
+  for (std::size_t lane = 0; lane < last - i; ++lane) lanes[lane].add(term(i + lane));
+  for (std::size_t lane = 1; lane < LanesV; ++lane) lanes[0].merge(lanes[lane]);
+
+  return lanes[0];
+}
+
+// Adds up term(i) for i in [first, last) with the given summation
+template<typename T, typename SumT, std::size_t LanesV, typename Term>
+inline Total<T, SumT> sumTerms(std::size_t first, std::size_t last, const Term& term)
+{
+  if constexpr (std::is_same_v<SumT, Summation::Pairwise>)
+  {
+    if (last - first <= PairwiseBlock) return Reduce::addTerms<Total<T, SumT>, LanesV>(first, last, term);
+
+    // Halves are cut on a multiple of the block size, so every block but the last is full
+    std::size_t middle = first + ((last - first) / 2 + PairwiseBlock - 1) / PairwiseBlock * PairwiseBlock;
+    Total<T, SumT> total = Reduce::sumTerms<T, SumT, LanesV>(first, middle, term);
+    total.merge(Reduce::sumTerms<T, SumT, LanesV>(middle, last, term));
+    return total;
+  }
+  else
+  {
+    return Reduce::addTerms<Total<T, SumT>, LanesV>(first, last, term);
+  }
+}
+
+inline unsigned threadCount(unsigned requested)
+{
+  if (requested != 0) return requested;
+
+  unsigned hardware = std::thread::hardware_concurrency();
+  return hardware != 0 ? hardware : 1;
+}
+
+// Reduces [0, n) with reduce(first, last), which gives back a PartialT, and combines the partial results with merge
+// The parallel policies cut the range into shares for each thread, and the partial results are always combined in order.
+template<typename PartialT, typename ExecT, typename ReduceRange, typename Merge>
+inline PartialT reduceRange(std::size_t n, const ExecT& execution, const ReduceRange& reduce, const Merge& merge)
+{
+  if constexpr (!IsParallel<ExecT>)
+  {
+    static_cast<void>(execution);
+    static_cast<void>(merge);
+    return reduce(0, n);
+  }
+  else
+  {
+    constexpr bool Fixed = std::is_same_v<ExecT, Execution::Deterministic>;
+
+    std::size_t threads = std::min<std::size_t>(Reduce::threadCount(execution.threads), n / MinThreadShare + 1);
+    std::size_t pieces = Fixed ? (n + ChunkSize - 1) / ChunkSize : threads;
+    if (pieces <= 1) return reduce(0, n);
+
+    std::size_t pieceSize = Fixed ? ChunkSize : (n + pieces - 1) / pieces;
+    std::vector<PartialT> partials(pieces);
+
+    // Thread t reduces pieces t, t + threads, t + 2 * threads and so on
+    auto work = [&](std::size_t thread)
+    {
+      for (std::size_t piece = thread; piece < pieces; piece += threads)
+      {
+        std::size_t first = std::min(n, piece * pieceSize);
+        partials[piece] = reduce(first, std::min(n, first + pieceSize));
+      }
+    };
+
+    threads = std::min(threads, pieces);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    for (std::size_t thread = 1; thread < threads; ++thread) workers.emplace_back(work, thread);
+    work(0);
+    for (std::thread& worker : workers) worker.join();
+
+    PartialT result = partials[0];
+    for (std::size_t piece = 1; piece < pieces; ++piece) merge(result, partials[piece]);
+    return result;
+  }
+}
+
+// Adds up term(i) for i in [0, n)
+template<typename T, typename ExecT, typename SumT, typename Term>
+inline T sum(std::size_t n, const ExecT& execution, const Term& term)
+{
+  using TotalT = Total<T, SumT>;
+
+  return Reduce::reduceRange<TotalT>(n, execution,
+    [&term](std::size_t first, std::size_t last) { return Reduce::sumTerms<T, SumT, LanesOf<ExecT>>(first, last, term); },
+    [](TotalT& total, const TotalT& other) { total.merge(other); }).result();
+}
+
+// The smallest (or with Greater, biggest) value, which is the first one when several are equal
+template<bool Greater, typename T, typename ExecT>
+inline T extreme(const T* values, std::size_t n, const ExecT& execution)
+{
+  auto better = [](const T& candidate, const T& current) { return Greater ? current < candidate : candidate < current; };
+
+  return Reduce::reduceRange<T>(n, execution,
+    [values, &better](std::size_t first, std::size_t last)
+    {
+      T best = values[first];
+      for (std::size_t i = first + 1; i < last; ++i) best = better(values[i], best) ? values[i] : best;
+      return best;
+    },
+    [&better](T& best, const T& other) { if (better(other, best)) best = other; });
+}
+
+template<typename M>
+inline const typename M::ValueType* valuesOf(std::span<const M> measurements)
+{
+  static_assert(Private::IsMeasurement<M>::value, "Only spans of measurements can be reduced.");
+  static_assert(sizeof(M) == sizeof(typename M::ValueType) && std::is_standard_layout_v<M>,
+                "Measurements have to be laid out like their values to be reduced.");
+  return reinterpret_cast<const typename M::ValueType*>(measurements.data());
+}
+
+}
+
+}
+
+// The sum of the measurements, in their units
+template<typename M, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+M sum(std::span<const M> measurements, ExecT execution = {}, SumT = {})
+{
+  using ValueType = typename M::ValueType;
+  const ValueType* values = Private::Reduce::valuesOf(measurements);
+
+  return M(Private::Reduce::sum<ValueType, ExecT, SumT>(measurements.size(), execution,
+    [values](std::size_t i) { return values[i]; }));
+}
+
+template<typename M, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+M sum(std::span<M> measurements, ExecT execution = {}, SumT summation = {})
+{
+  return MetaMeasure::sum(std::span<const M>(measurements), execution, summation);
+}
+
+// The mean of the measurements, in their units
+// Integer means are truncated like integer division, and the mean of no measurements throws a std::invalid_argument.
+template<typename M, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+M mean(std::span<const M> measurements, ExecT execution = {}, SumT summation = {})
+{
+  if (measurements.empty())
+  {
+    throw std::invalid_argument("MetaMeasure: there's no mean of no measurements");
+  }
+
+  using ValueType = typename M::ValueType;
+  return M(MetaMeasure::sum(measurements, execution, summation).value() / static_cast<ValueType>(measurements.size()));
+}
+
+template<typename M, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+M mean(std::span<M> measurements, ExecT execution = {}, SumT summation = {})
+{
+  return MetaMeasure::mean(std::span<const M>(measurements), execution, summation);
+}
+
+// The smallest measurement, which throws a std::invalid_argument if there aren't any
+template<typename M, typename ExecT = Execution::Sequential>
+M min(std::span<const M> measurements, ExecT execution = {})
+{
+  if (measurements.empty())
+  {
+    throw std::invalid_argument("MetaMeasure: there's no smallest of no measurements");
+  }
+
+  return M(Private::Reduce::extreme<false>(Private::Reduce::valuesOf(measurements), measurements.size(), execution));
+}
+
+template<typename M, typename ExecT = Execution::Sequential>
+M min(std::span<M> measurements, ExecT execution = {})
+{
+  return MetaMeasure::min(std::span<const M>(measurements), execution);
+}
+
+// The biggest measurement, which throws a std::invalid_argument if there aren't any
+template<typename M, typename ExecT = Execution::Sequential>
+M max(std::span<const M> measurements, ExecT execution = {})
+{
+  if (measurements.empty())
+  {
+    throw std::invalid_argument("MetaMeasure: there's no biggest of no measurements");
+  }
+
+  return M(Private::Reduce::extreme<true>(Private::Reduce::valuesOf(measurements), measurements.size(), execution));
+}
+
+template<typename M, typename ExecT = Execution::Sequential>
+M max(std::span<M> measurements, ExecT execution = {})
+{
+  return MetaMeasure::max(std::span<const M>(measurements), execution);
+}
+
+// The sum of the products of l and r, measured like l[i] * r[i] would be, so 2 spans of meters give square meters
+// l and r have to be the same length, or a std::length_error is thrown.
+template<typename L, typename R, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+auto dot(std::span<const L> l, std::span<const R> r, ExecT execution = {}, SumT = {})
+{
+  using Result = decltype(std::declval<const L&>() * std::declval<const R&>());
+  using ValueType = typename Result::ValueType;
+
+  if (l.size() != r.size())
+  {
+    throw std::length_error("MetaMeasure: the spans of a dot product have different lengths");
+  }
+
+  if constexpr (std::is_floating_point_v<ValueType>)
+  {
+    // Multiplying measurements only scales the product of their values, so the scaling can wait until the end
+    constexpr ValueType Scale = (L(1) * R(1)).value();
+    const auto* lValues = Private::Reduce::valuesOf(l);
+    const auto* rValues = Private::Reduce::valuesOf(r);
+
+    ValueType total = Private::Reduce::sum<ValueType, ExecT, SumT>(l.size(), execution,
+      [lValues, rValues](std::size_t i) { return static_cast<ValueType>(lValues[i]) * static_cast<ValueType>(rValues[i]); });
+
+    return Result(Scale == 1 ? total : total * Scale);
+  }
+  else
+  {
+    return Result(Private::Reduce::sum<ValueType, ExecT, SumT>(l.size(), execution,
+      [&l, &r](std::size_t i) { return (l[i] * r[i]).value(); }));
+  }
+}
+
+template<typename L, typename R, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+auto dot(std::span<L> l, std::span<R> r, ExecT execution = {}, SumT summation = {})
+{
+  return MetaMeasure::dot(std::span<const L>(l), std::span<const R>(r), execution, summation);
+}
+
+// The Euclidean norm of the measurements, in their units
+template<typename M, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+M norm(std::span<const M> measurements, ExecT execution = {}, SumT = {})
+{
+  using ValueType = typename M::ValueType;
+  static_assert(std::is_floating_point_v<ValueType>, "Only measurements with floating point values have a norm.");
+
+  const ValueType* values = Private::Reduce::valuesOf(measurements);
+
+  return M(std::sqrt(Private::Reduce::sum<ValueType, ExecT, SumT>(measurements.size(), execution,
+    [values](std::size_t i) { return values[i] * values[i]; })));
+}
+
+template<typename M, typename ExecT = Execution::Sequential, typename SumT = Summation::Pairwise>
+M norm(std::span<M> measurements, ExecT execution = {}, SumT summation = {})
+{
+  return MetaMeasure::norm(std::span<const M>(measurements), execution, summation);
+}
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef METAMEASURE_SYMBOLS_INCLUDED
+#define METAMEASURE_SYMBOLS_INCLUDED
+
+// The unit symbols MetaMeasure reads and writes, listed at compile time
+// A unit's symbol is the suffix of its literal without the underscore, so "km" for _km,
+// And the list is made by expanding the lists of literals with METAMEASURE_LITERAL redefined to add a symbol.
+// So any unit whose literals are in METAMEASURE_SI_LITERALS or METAMEASURE_CUSTOMARY_LITERALS has a symbol.
+
+#include <MetaMeasure.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+namespace Private
+{
+
+namespace Symbols
+{
+
+// The longest symbol there can be; every symbol fits in a 64-bit key
+inline constexpr std::size_t MaxSymbolLength = 8;
+
+// Packs a symbol into an integer, 1 character per byte
+// Symbols never contain '\0', so 2 symbols are the same exactly when their keys are.
+constexpr std::uint64_t keyOf(const char* symbol, std::size_t length)
+{
+  std::uint64_t key = 0;
+
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    key |= static_cast<std::uint64_t>(static_cast<unsigned char>(symbol[i])) << (8 * i);
+  }
+
+  return key;
+}
+
+constexpr long double toLongDouble(const Rational& r)
+{
+  return static_cast<long double>(r.num) / static_cast<long double>(r.den);
+}
+
+// A unit symbol and what it stands for
+struct Symbol
+{
+  char name[MaxSymbolLength] = {};
+  std::size_t length = 0;
+  std::uint64_t key = 0;
+  ExponentType exponents[DimensionCount] = {0, 0, 0, 0, 0, 0, 0};
+
+  // How many of this unit there are in a base unit, like a DimensionVector's ratio
+  Rational ratio = {};
+
+  // How many base units 1 of this unit is
+  long double factor = 1;
+
+  constexpr std::string_view view() const { return std::string_view(this->name, this->length); }
+};
+
+// Checks if a symbol is for a unit to the power of -1, like Hz
+constexpr bool isReciprocal(const Symbol& symbol)
+{
+  for (ExponentType e : symbol.exponents)
+  {
+    if (e < 0) return true;
+  }
+
+  return false;
+}
+
+// The symbols of every literal, in the order they're defined
+// 2 literals can have the same suffix (_nm is nanometers and nautical miles), so symbols aren't always unique.
+struct SymbolList
+{
+  static constexpr std::size_t Capacity = 255;
+
+  Symbol symbols[Capacity] = {};
+  std::size_t count = 0;
+
+  // Adds the symbol for a literal's suffix
+  template<typename M>
+  constexpr void add(std::string_view suffix)
+  {
+    std::string_view name = suffix.substr(1);
+
+    if (name.size() > MaxSymbolLength || this->count == Capacity)
+    {
+      throw std::length_error("MetaMeasure: too many unit symbols, or one that's too long");
+    }
+
+    Symbol& symbol = this->symbols[this->count++];
+    for (std::size_t i = 0; i < name.size(); ++i) symbol.name[i] = name[i];
+    symbol.length = name.size();
+    symbol.key = Symbols::keyOf(name.data(), name.size());
+
+    for (std::size_t i = 0; i < DimensionCount; ++i)
+    {
+      symbol.exponents[i] = M::Dimensions.exponents[i];
+    }
+
+    symbol.ratio = M::Dimensions.ratio;
+
+    // The literals for reciprocal units, like _kHz, put the prefix on the unit they're the reciprocal of (1 per kilosecond),
+    // But in text it's on the whole symbol (1000 per second), so these get the ratio the prefix has on the whole symbol
+    if (Symbols::isReciprocal(symbol)) symbol.ratio = Rational() / symbol.ratio;
+
+    symbol.factor = Symbols::toLongDouble(Rational() / symbol.ratio);
+  }
+};
+
+#pragma push_macro("METAMEASURE_LITERAL")
+#pragma push_macro("METAMEASURE_FORCE_SEMICOLON")
+#undef METAMEASURE_LITERAL
+#undef METAMEASURE_FORCE_SEMICOLON
+#define METAMEASURE_LITERAL(UNIT, EXPONENT, SUFFIX) list.add<UNIT<long double, EXPONENT>>(#SUFFIX)
+#define METAMEASURE_FORCE_SEMICOLON static_cast<void>(0)
+
+consteval SymbolList listSymbols()
+{
+  SymbolList list;
+  METAMEASURE_SI_LITERALS;
+  METAMEASURE_CUSTOMARY_LITERALS;
+  return list;
+}
+
+#pragma pop_macro("METAMEASURE_FORCE_SEMICOLON")
+#pragma pop_macro("METAMEASURE_LITERAL")
+
+inline constexpr SymbolList ListedSymbols = Symbols::listSymbols();
+
+// Every symbol, without the unused space at the end of the list
+inline constexpr auto AllSymbols = []()
+{
+  std::array<Symbol, ListedSymbols.count> symbols;
+  for (std::size_t i = 0; i < symbols.size(); ++i) symbols[i] = ListedSymbols.symbols[i];
+  return symbols;
+}();
+
+// Checks if a symbol is the unit its text is read as
+// When 2 literals have the same suffix, the text means the first one, so "nm" is nanometers and not nautical miles.
+constexpr bool isReadAs(const Symbol& symbol)
+{
+  for (const Symbol& other : AllSymbols)
+  {
+    if (other.key == symbol.key) return &other == &symbol;
+  }
+
+  return false;
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef METAMEASURE_TABLE_INCLUDED
+#define METAMEASURE_TABLE_INCLUDED
+
+// Tables of records made of measurements, stored one column at a time
+// Every column is its own MeasurementArray, so going over one column only touches that column's memory,
+// And columns can be used in array expressions like any other array.
+
+#include <MetaMeasure/Array.hpp>
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// A table whose columns hold the given measurement types
+// Columns are picked by index; an enum makes that readable:
+//
+// enum Columns { Position, Velocity, Mass };
+// MeasurementTable<Meters<double>, Measurement<double, UnitMeters<1>, UnitSeconds<-1>>, Kilograms<double>> table;
+// table.append(3.0_m, 2.0_m / 1.0_s, 5.0_kg);
+// table.column<Position>() += table.column<Velocity>() * Seconds<double>(0.5);
+template<typename... Columns>
+class MeasurementTable
+{
+  static_assert(sizeof...(Columns) > 0, "A table needs at least 1 column.");
+  static_assert((Private::IsMeasurement<Columns>::value && ...), "The columns of a table have to be measurements.");
+
+  using ThisType = MeasurementTable<Columns...>;
+  using Storage = std::tuple<BasicMeasurementArray<typename Columns::ValueType, Columns::Dimensions>...>;
+
+public:
+  // The array column I is stored in
+  template<std::size_t I>
+  using Column = std::tuple_element_t<I, Storage>;
+
+  static constexpr std::size_t ColumnCount = sizeof...(Columns);
+
+private:
+  // Applies f to every column
+  template<typename F>
+  void forEachColumn(F f)
+  {
+    std::apply([&f](auto&... columns) { (f(columns), ...); }, this->columns);
+  }
+
+public:
+  // One row of the table
+  // Its elements are read and written through get<I>(), like the elements of an array.
+  template<bool Const>
+  class BasicRow
+  {
+  public:
+    template<std::size_t I>
+    auto get() const
+    {
+      return this->table->template column<I>()[this->i];
+    }
+
+    // Assigns every element of the row at once
+    // The measurements can be in any units with the right dimensions.
+    template<typename... Ms, bool C = Const, std::enable_if_t<!C && sizeof...(Ms) == ColumnCount, int> = 0>
+    const BasicRow& set(const Ms&... values) const
+    {
+      this->setColumns(std::index_sequence_for<Ms...>(), values...);
+      return *this;
+    }
+
+    std::size_t index() const { return this->i; }
+
+  private:
+    friend class MeasurementTable;
+
+    using TableType = std::conditional_t<Const, const ThisType, ThisType>;
+
+    BasicRow(TableType& t, std::size_t index) : table(&t), i(index) {}
+
+    template<std::size_t... Is, typename... Ms>
+    void setColumns(std::index_sequence<Is...>, const Ms&... values) const
+    {
+      ((this->table->template column<Is>()[this->i] = values), ...);
+    }
+
+    TableType* table;
+    std::size_t i;
+  };
+
+  using Row = BasicRow<false>;
+  using ConstRow = BasicRow<true>;
+
+  // Goes over the rows of a table
+  template<bool Const>
+  class BasicRowIterator
+  {
+  public:
+    BasicRow<Const> operator*() const { return BasicRow<Const>(*this->table, this->i); }
+
+    BasicRowIterator& operator++()
+    {
+      ++this->i;
+      return *this;
+    }
+
+    bool operator==(const BasicRowIterator& other) const { return this->i == other.i; }
+    bool operator!=(const BasicRowIterator& other) const { return this->i != other.i; }
+
+  private:
+    friend class MeasurementTable;
+
+    using TableType = std::conditional_t<Const, const ThisType, ThisType>;
+
+    BasicRowIterator(TableType& t, std::size_t index) : table(&t), i(index) {}
+
+    TableType* table;
+    std::size_t i;
+  };
+
+  MeasurementTable() = default;
+
+  explicit MeasurementTable(std::size_t rows)
+  {
+    this->resize(rows);
+  }
+
+  std::size_t size() const { return std::get<0>(this->columns).size(); }
+  bool empty() const { return this->size() == 0; }
+
+  void reserve(std::size_t rows)
+  {
+    this->forEachColumn([rows](auto& column) { column.reserve(rows); });
+  }
+
+  void resize(std::size_t rows)
+  {
+    this->reserveFor(rows);
+    this->forEachColumn([rows](auto& column) { column.resize(rows); });
+  }
+
+  void clear()
+  {
+    this->forEachColumn([](auto& column) { column.clear(); });
+  }
+
+  // Adds a row at the end
+  // The measurements can be in any units with the right dimensions; they're converted into the column's.
+  template<typename... Ms, std::enable_if_t<sizeof...(Ms) == ColumnCount, int> = 0>
+  void append(const Ms&... values)
+  {
+    this->appendColumns(std::index_sequence_for<Ms...>(), values...);
+  }
+
+  // The array a column is stored in
+  // Change its elements all you like, but leave its size alone; every column has to have as many rows as the table.
+  template<std::size_t I>
+  Column<I>& column() { return std::get<I>(this->columns); }
+
+  template<std::size_t I>
+  const Column<I>& column() const { return std::get<I>(this->columns); }
+
+  // The bare values of a column, in its units
+  template<std::size_t I>
+  std::span<typename Column<I>::ValueType> values() { return std::get<I>(this->columns).values(); }
+
+  template<std::size_t I>
+  std::span<const typename Column<I>::ValueType> values() const { return std::get<I>(this->columns).values(); }
+
+  Row operator[](std::size_t row) { return Row(*this, row); }
+  ConstRow operator[](std::size_t row) const { return ConstRow(*this, row); }
+
+  BasicRowIterator<false> begin() { return BasicRowIterator<false>(*this, 0); }
+  BasicRowIterator<false> end() { return BasicRowIterator<false>(*this, this->size()); }
+  BasicRowIterator<true> begin() const { return BasicRowIterator<true>(*this, 0); }
+  BasicRowIterator<true> end() const { return BasicRowIterator<true>(*this, this->size()); }
+
+private:
+  Storage columns;
+
+  // Makes room for rows in every column before any of them grows
+  // Only this can throw, so a table that runs out of memory still has the same number of rows in every column.
+  void reserveFor(std::size_t rows)
+  {
+    this->forEachColumn([rows](auto& column)
+    {
+      if (column.capacity() < rows) column.reserve(rows > 2 * column.capacity() ? rows : 2 * column.capacity());
+    });
+  }
+
+  template<std::size_t... Is, typename... Ms>
+  void appendColumns(std::index_sequence<Is...>, const Ms&... values)
+  {
+    this->reserveFor(this->size() + 1);
+    (std::get<Is>(this->columns).push_back(values), ...);
+  }
+};
+
+}
+
+#endif
@@ -1,7 +1,16 @@
 #ifndef METAMEASURE_UNITBASE_INCLUDED
 #define METAMEASURE_UNITBASE_INCLUDED
 
-namespace MetaMeasure
+#include <cstddef>
+#include <tuple>
+
+// The module interface (MetaMeasure.cppm) defines this as export before including the headers
+// Everywhere else it's nothing
+#ifndef METAMEASURE_EXPORT
+#define METAMEASURE_EXPORT
+#endif
+
+METAMEASURE_EXPORT namespace MetaMeasure
 {
 
 using ExponentType = int;
@@ -29,6 +38,31 @@ struct Current {};
 struct Luminosity {};
 struct SubstanceQuantity {};
 
+// How many dimensions a measurement can have
+inline constexpr std::size_t DimensionCount = 7;
+
+// The order dimensions are always listed in
+// This is the key units get sorted by, so any 2 measurements with the same units list them the same way
+using DimensionOrder = std::tuple<Length, Mass, Time, Temperature, Current, Luminosity, SubstanceQuantity>;
+
+// Gives each dimension a fixed slot in a measurement's dimension vector
+// Every measurement is expressed in terms of these 7, so only they have a slot
+// The slots match DimensionOrder
+template<typename IdentifierT>
+struct DimensionIndex
+{
+  static_assert(sizeof(IdentifierT) == 0,
+                "Dimension is not one of the 7 SI dimensions.");
+};
+
+template<> struct DimensionIndex<Length>            { static constexpr std::size_t Value = 0; };
+template<> struct DimensionIndex<Mass>              { static constexpr std::size_t Value = 1; };
+template<> struct DimensionIndex<Time>              { static constexpr std::size_t Value = 2; };
+template<> struct DimensionIndex<Temperature>       { static constexpr std::size_t Value = 3; };
+template<> struct DimensionIndex<Current>           { static constexpr std::size_t Value = 4; };
+template<> struct DimensionIndex<Luminosity>        { static constexpr std::size_t Value = 5; };
+template<> struct DimensionIndex<SubstanceQuantity> { static constexpr std::size_t Value = 6; };
+
 }
 
 #endif
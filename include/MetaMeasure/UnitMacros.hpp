@@ -0,0 +1,275 @@
+#ifndef METAMEASURE_UNITMACROS_INCLUDED
+#define METAMEASURE_UNITMACROS_INCLUDED
+
+// The macros used to define units and literals
+// This only defines macros, so it can also be included next to "import MetaMeasure;"
+// Which is how you'd define your own units when using the module.
+
+#include <ratio>
+
+// This is for compilers that warn about extra semi-colons, even though they're perfectly legal
+#define METAMEASURE_FORCE_SEMICOLON \
+extern void* MetaMeasureSemicolonForcer_
+
+// Does the same thing as METAMEASURE_UNIT except you pass in a type for RATIO
+// Use a typedef for it, as macros hate commas
+#define METAMEASURE_UNIT_WITH_RATIO_TYPE(NAME, DIMENSION, RATIO) \
+template<MetaMeasure::ExponentType Exponent = 1> \
+using Unit##NAME = MetaMeasure::Unit<MetaMeasure::Dimension<DIMENSION, Exponent>, RATIO>; \
+template<typename NumT, MetaMeasure::ExponentType Exponent = 1> \
+using NAME = MetaMeasure::Measurement<NumT, Unit##NAME<Exponent>>; \
+METAMEASURE_FORCE_SEMICOLON
+
+// Creates 2 type definitions for a unit:
+// The first type definition will be called Unit##NAME.
+// This is just used to specify that a measurement uses the unit.
+// The other type definition will be called NAME, which is a MetaMeasure::Measurement that only uses the unit.
+// See the examples in the header below
+// DIMENSION is the quantity that is measured (i.e. MetaMeasure::Length)
+// RATIO_NUM is the conversion ratio's numerator
+// RATIO_DEN is the conversion ratio's denominator
+// The conversion ratio is a ratio that, if multiplied by your measurement, converts the measurement to base units.
+// In the case of MetaMeasure::Length, it would convert your measurement to meters.
+#define METAMEASURE_UNIT(NAME, DIMENSION, RATIO_NUM, RATIO_DEN) \
+template<MetaMeasure::ExponentType Exponent = 1> \
+using Unit##NAME = MetaMeasure::Unit<MetaMeasure::Dimension<DIMENSION, Exponent>, std::ratio<RATIO_NUM, RATIO_DEN>>; \
+template<typename NumT, MetaMeasure::ExponentType Exponent = 1> \
+using NAME = MetaMeasure::Measurement<NumT, Unit##NAME<Exponent>>; \
+METAMEASURE_FORCE_SEMICOLON
+
+// All of the literals below are consteval, which makes them inline and always evaluated at compile time
+// So 10.0_m is just the constant 10 in the generated code, even without optimizations,
+// No object file gets a symbol for them, and including them in several translation units is fine.
+
+// The type a literal returns depends on MetaMeasureLiteralMode, which is looked up where the macro is used
+// By default, floating literals give a measurement that uses a long double as its value type,
+// And integer literals one that uses a long long int (see MetaMeasure/Literals.hpp to change that).
+
+// Defines a literal for a single unit measurement which uses a long double as its parameter
+// UNIT is the name of the unit (not the full type name!)
+// SUFFIX is the suffix the literal will use
+#define METAMEASURE_LITERAL_LD(UNIT, EXPONENT, SUFFIX) \
+consteval auto operator"" SUFFIX (long double v) \
+{ \
+  return MetaMeasure::Private::makeLiteral<UNIT<long double, EXPONENT>, MetaMeasureLiteralMode>(v); \
+} \
+METAMEASURE_FORCE_SEMICOLON
+
+// Defines a literal for a single unit measurement which uses an unsigned long long int as its parameter
+// UNIT is the name of the unit (not the full type name!)
+// SUFFIX is the suffix the literal will use
+#define METAMEASURE_LITERAL_ULL(UNIT, EXPONENT, SUFFIX) \
+consteval auto operator"" SUFFIX (unsigned long long int v) \
+{ \
+  return MetaMeasure::Private::makeLiteral<UNIT<long double, EXPONENT>, MetaMeasureLiteralMode>(v); \
+} \
+METAMEASURE_FORCE_SEMICOLON
+
+// Defines a literal for a measurement which uses a long double as its parameter
+// TYPE is the type of the measurement
+// SUFFIX is the suffix the literal will use
+#define METAMEASURE_LITERAL_LD_WITH_TYPE(TYPE, SUFFIX) \
+consteval TYPE operator"" SUFFIX (long double v) \
+{ \
+  return static_cast<MetaMeasure::LongDoubleLiteralResult>(v); \
+} \
+METAMEASURE_FORCE_SEMICOLON
+
+// Defines a literal for a unit which uses an unsigned long long int as its parameter
+// UNIT is the MetaMeasure::Measurement that will be returned
+// SUFFIX is the suffix the literal will use
+#define METAMEASURE_LITERAL_ULL_WITH_TYPE(TYPE, SUFFIX) \
+consteval TYPE operator"" SUFFIX (unsigned long long int v) \
+{ \
+  return static_cast<MetaMeasure::UnsignedLongLongLiteralResult>(v); \
+} \
+METAMEASURE_FORCE_SEMICOLON
+
+// Combination of METAMEASURE_LITERAL_LD & METAMEASURE_LITERAL_ULL
+#define METAMEASURE_LITERAL(UNIT, EXPONENT, SUFFIX) \
+METAMEASURE_LITERAL_LD(UNIT, EXPONENT, SUFFIX); \
+METAMEASURE_LITERAL_ULL(UNIT, EXPONENT, SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+
+// Combination of METAMEASURE_LITERAL_LD_WITH_TYPE & METAMEASURE_LITERAL_ULL_WITH_TYPE
+#define METAMEASURE_LITERAL_WITH_TYPE(TYPE, SUFFIX) \
+METAMEASURE_LITERAL_LD_WITH_TYPE(TYPE, SUFFIX); \
+METAMEASURE_LITERAL_ULL_WITH_TYPE(TYPE, SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+
+#ifdef METAMEASURE_ZETTA_AND_ZEPTO_SUPPORTED
+#define _METAMEASURE_ZETTA_AND_ZEPTO_RATIOS \
+using Zetta = MetaMeasure::RatioOf<MetaMeasure::Rational(Main()) / MetaMeasure::pow(10, 21)>; \
+using Zepto = MetaMeasure::RatioOf<MetaMeasure::Rational(Main()) / MetaMeasure::pow(10, -21)>; \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_ZETTA_AND_ZEPTO_UNITS(NAME, DIMENSION) \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Zetta##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Zetta); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Zepto##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Zepto); \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_ZETTA_AND_ZEPTO_LITERALS(NAMESPACE, UNIT, EXPONENT, SUFFIX) \
+METAMEASURE_LITERAL(NAMESPACE Zetta##UNIT, EXPONENT, _Z##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Zepto##UNIT, EXPONENT, _z##SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_ZETTA_AND_ZEPTO_LITERALS_WITH_TYPE(TYPE, SUFFIX) \
+METAMEASURE_LITERAL_WITH_TYPE(Zetta##TYPE, _Z##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Zepto##TYPE, _z##SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+#else
+#define _METAMEASURE_ZETTA_AND_ZEPTO_RATIOS \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_ZETTA_AND_ZEPTO_UNITS(NAME, DIMENSION) \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_ZETTA_AND_ZEPTO_LITERALS(NAMESPACE, UNIT, EXPONENT, SUFFIX) \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_ZETTA_AND_ZEPTO_LITERALS_WITH_TYPE(TYPE, SUFFIX) \
+METAMEASURE_FORCE_SEMICOLON
+#endif
+
+#ifdef METAMEASURE_YOTTA_AND_YOCTO_SUPPORTED
+#define _METAMEASURE_YOTTA_AND_YOCTO_RATIOS \
+using Yotta = MetaMeasure::RatioOf<MetaMeasure::Rational(Main()) / MetaMeasure::pow(10, 24)>; \
+using Yocto = MetaMeasure::RatioOf<MetaMeasure::Rational(Main()) / MetaMeasure::pow(10, -24)>; \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_YOTTA_AND_YOCTO_UNITS(NAME, DIMENSION) \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Yotta##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Yotta); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Yocto##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Yocto); \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_YOTTA_AND_YOCTO_LITERALS(NAMESPACE, UNIT, EXPONENT, SUFFIX) \
+METAMEASURE_LITERAL(NAMESPACE Yotta##UNIT, EXPONENT, _Y##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Yocto##UNIT, EXPONENT, _y##SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_YOTTA_AND_YOCTO_LITERALS_WITH_TYPE(TYPE, SUFFIX) \
+METAMEASURE_LITERAL_WITH_TYPE(Yotta##TYPE, _Y##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Yocto##TYPE, _y##SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+#else
+#define _METAMEASURE_YOTTA_AND_YOCTO_RATIOS \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_YOTTA_AND_YOCTO_UNITS(NAME, DIMENSION) \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_YOTTA_AND_YOCTO_LITERALS(NAMESPACE, UNIT, EXPONENT, SUFFIX) \
+METAMEASURE_FORCE_SEMICOLON
+
+#define _METAMEASURE_YOTTA_AND_YOCTO_LITERALS_WITH_TYPE(TYPE, SUFFIX) \
+METAMEASURE_FORCE_SEMICOLON
+#endif
+
+// Macro to make a type with all of the metric prefixes, save for the one without a prefix
+// See METAMEASURE_UNIT_WITH_RATIO_TYPE for instructions, as the parameters are the same
+#define METAMEASURE_UNIT_WITH_RATIO_TYPE_AND_METRIC_PREFIXES(NAME, DIMENSION, RATIO) \
+namespace _METAMEASURE_RATIOS_1_##NAME \
+{ \
+  using Main  = RATIO; \
+  using Exa   = std::ratio_divide<Main, std::exa>; \
+  using Peta  = std::ratio_divide<Main, std::peta>; \
+  using Tera  = std::ratio_divide<Main, std::tera>; \
+  using Giga  = std::ratio_divide<Main, std::giga>; \
+  using Mega  = std::ratio_divide<Main, std::mega>; \
+  using Kilo  = std::ratio_divide<Main, std::kilo>; \
+  using Hecto = std::ratio_divide<Main, std::hecto>; \
+  using Deca  = std::ratio_divide<Main, std::deca>; \
+  using Deci  = std::ratio_divide<Main, std::deci>; \
+  using Centi = std::ratio_divide<Main, std::centi>; \
+  using Milli = std::ratio_divide<Main, std::milli>; \
+  using Micro = std::ratio_divide<Main, std::micro>; \
+  using Nano  = std::ratio_divide<Main, std::nano>; \
+  using Pico  = std::ratio_divide<Main, std::pico>; \
+  using Femto = std::ratio_divide<Main, std::femto>; \
+  using Atto  = std::ratio_divide<Main, std::atto>; \
+  _METAMEASURE_ZETTA_AND_ZEPTO_RATIOS; \
+  _METAMEASURE_YOTTA_AND_YOCTO_RATIOS; \
+} \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Exa##NAME,   DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Exa); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Peta##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Peta); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Tera##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Tera); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Giga##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Giga); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Mega##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Mega); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Kilo##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Kilo); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Hecto##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Hecto); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Deca##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Deca); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Deci##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Deci); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Centi##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Centi); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Milli##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Milli); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Micro##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Micro); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Nano##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Nano); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Pico##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Pico); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Femto##NAME, DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Femto); \
+METAMEASURE_UNIT_WITH_RATIO_TYPE(Atto##NAME,  DIMENSION, _METAMEASURE_RATIOS_1_##NAME::Atto); \
+_METAMEASURE_ZETTA_AND_ZEPTO_UNITS(NAME, DIMENSION); \
+_METAMEASURE_YOTTA_AND_YOCTO_UNITS(NAME, DIMENSION); \
+METAMEASURE_FORCE_SEMICOLON
+
+// Macro to make a type with all of the metric prefixes, save for the one without a prefix
+// See METAMEASURE_UNIT for instructions, as the parameters are the same
+#define METAMEASURE_UNIT_WITH_METRIC_PREFIXES(NAME, DIMENSION, RATIO_NUM, RATIO_DEN) \
+namespace _METAMEASURE_RATIOS_2_##NAME { using Main  = std::ratio<RATIO_NUM, RATIO_DEN>; } \
+METAMEASURE_UNIT_WITH_RATIO_TYPE_AND_METRIC_PREFIXES(NAME, DIMENSION, _METAMEASURE_RATIOS_2_##NAME::Main); \
+METAMEASURE_FORCE_SEMICOLON
+
+// Creates literals with metric prefixes. Be sure to have already created the units.
+// That must be done using either METAMEASURE_UNIT_WITH_METRIC_PREFIXES
+// Or METAMEASURE_UNIT_WITH_METRIC_PREFIXES_WITH_RATIO_TYPE
+// Note that this puts the underscore in for you for your suffix.
+#define METAMEASURE_LITERAL_WITH_METRIC_PREFIXES(UNIT, EXPONENT, SUFFIX) \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(, UNIT, EXPONENT, SUFFIX)
+
+// Same as METAMEASURE_LITERAL_WITH_METRIC_PREFIXES, but the units are looked up in NAMESPACE
+// NAMESPACE is everything that goes before the unit's name, like MetaMeasure::
+// This is for defining literals outside of the namespace the units are in.
+#define METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(NAMESPACE, UNIT, EXPONENT, SUFFIX) \
+METAMEASURE_LITERAL(NAMESPACE Exa##UNIT,   EXPONENT, _E##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Peta##UNIT,  EXPONENT, _P##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Tera##UNIT,  EXPONENT, _T##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Giga##UNIT,  EXPONENT, _G##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Mega##UNIT,  EXPONENT, _M##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Kilo##UNIT,  EXPONENT, _k##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Hecto##UNIT, EXPONENT, _h##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Deca##UNIT,  EXPONENT, _da##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Deci##UNIT,  EXPONENT, _d##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Centi##UNIT, EXPONENT, _c##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Milli##UNIT, EXPONENT, _m##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Micro##UNIT, EXPONENT, _u##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Nano##UNIT,  EXPONENT, _n##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Pico##UNIT,  EXPONENT, _p##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Femto##UNIT, EXPONENT, _f##SUFFIX); \
+METAMEASURE_LITERAL(NAMESPACE Atto##UNIT,  EXPONENT, _a##SUFFIX); \
+_METAMEASURE_ZETTA_AND_ZEPTO_LITERALS(NAMESPACE, UNIT, EXPONENT, SUFFIX); \
+_METAMEASURE_YOTTA_AND_YOCTO_LITERALS(NAMESPACE, UNIT, EXPONENT, SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+
+// See METAMEASURE_LITERAL_WITH_METRIC_PREFIXES
+// You specify the type directly through TYPE instead of putting in a unit and exponent.
+// The type should be a typedef though, since macros don't like commas
+#define METAMEASURE_LITERAL_WITH_TYPE_AND_METRIC_PREFIXES(TYPE, SUFFIX) \
+METAMEASURE_LITERAL_WITH_TYPE(Exa##TYPE,   _E##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Peta##TYPE,  _P##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Tera##TYPE,  _T##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Giga##TYPE,  _G##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Mega##TYPE,  _M##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Kilo##TYPE,  _k##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Hecto##TYPE, _h##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Deca##TYPE,  _da##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Deci##TYPE,  _d##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Centi##TYPE, _c##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Milli##TYPE, _m##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Micro##TYPE, _u##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Nano##TYPE,  _n##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Pico##TYPE,  _p##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Femto##TYPE, _f##SUFFIX); \
+METAMEASURE_LITERAL_WITH_TYPE(Atto##TYPE,  _a##SUFFIX); \
+_METAMEASURE_ZETTA_AND_ZEPTO_LITERALS_WITH_TYPE(TYPE, SUFFIX); \
+_METAMEASURE_YOTTA_AND_YOCTO_LITERALS_WITH_TYPE(TYPE, SUFFIX); \
+METAMEASURE_FORCE_SEMICOLON
+
+#endif
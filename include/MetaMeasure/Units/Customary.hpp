@@ -0,0 +1,14 @@
+#ifndef METAMEASURE_UNITS_CUSTOMARY_INCLUDED
+#define METAMEASURE_UNITS_CUSTOMARY_INCLUDED
+
+// All of the customary units
+// Include the headers in MetaMeasure/Units/Customary/ directly if you only need some of them
+
+#include <MetaMeasure/Units/Customary/Length.hpp>
+
+// Every customary literal, for use in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_CUSTOMARY_LITERALS \
+METAMEASURE_CUSTOMARY_LENGTH_LITERALS; \
+METAMEASURE_FORCE_SEMICOLON
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef METAMEASURE_UNITS_CUSTOMARY_LENGTH_INCLUDED
+#define METAMEASURE_UNITS_CUSTOMARY_LENGTH_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// Customary lengths
+// To give an example of how the conversion ratios work, there are exactly 2.54 centimeters in an inch.
+// There are 100 centimeters for every 1 meter, and thus 100 inches for every 2.54 meters.
+// Since std::ratio can only hold whole numbers, the ratio will be 10000 inches to 254 meters.
+// We can simplify this down to 5000 inches per 127 meters.
+
+METAMEASURE_UNIT(Points, Length, 360000, 127);
+METAMEASURE_UNIT(Pica, Length, 30000, 127);
+METAMEASURE_UNIT(Inches, Length, 5000, 127); // ratio from above
+METAMEASURE_UNIT(Feet, Length, 1250, 381);
+METAMEASURE_UNIT(Yards, Length, 1250, 1143);
+METAMEASURE_UNIT(Miles, Length, 2200000, 1143);
+METAMEASURE_UNIT(Links, Length, 825, 381);
+METAMEASURE_UNIT(SurveyFeet, Length, 3937, 1200);
+METAMEASURE_UNIT(Rods, Length, 6875, 127);
+METAMEASURE_UNIT(Chains, Length, 27500, 127);
+METAMEASURE_UNIT(Furlongs, Length, 275000, 127);
+METAMEASURE_UNIT(SurveyMiles, Length, 2200000, 127);
+METAMEASURE_UNIT(Leagues, Length, 6600000, 127);
+METAMEASURE_UNIT(Fathoms, Length, 2500, 1143);
+METAMEASURE_UNIT(Cables, Length, 100000, 381);
+METAMEASURE_UNIT(NauticalMiles, Length, 281300, 127);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_CUSTOMARY_LENGTH_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Points, 1, _pt); \
+METAMEASURE_LITERAL(MetaMeasure::Pica, 1, _pc); \
+METAMEASURE_LITERAL(MetaMeasure::Inches, 1, _in); \
+METAMEASURE_LITERAL(MetaMeasure::Feet, 1, _ft); \
+METAMEASURE_LITERAL(MetaMeasure::Yards, 1, _yd); \
+METAMEASURE_LITERAL(MetaMeasure::Miles, 1, _mi); \
+METAMEASURE_LITERAL(MetaMeasure::Links, 1, _li); \
+METAMEASURE_LITERAL(MetaMeasure::SurveyFeet, 1, _sft); \
+METAMEASURE_LITERAL(MetaMeasure::Rods, 1, _rd); \
+METAMEASURE_LITERAL(MetaMeasure::Chains, 1, _ch); \
+METAMEASURE_LITERAL(MetaMeasure::Furlongs, 1, _fur); \
+METAMEASURE_LITERAL(MetaMeasure::SurveyMiles, 1, _smi); \
+METAMEASURE_LITERAL(MetaMeasure::Leagues, 1, _lea); \
+METAMEASURE_LITERAL(MetaMeasure::Fathoms, 1, _ftm); \
+METAMEASURE_LITERAL(MetaMeasure::Cables, 1, _cb); \
+METAMEASURE_LITERAL(MetaMeasure::NauticalMiles, 1, _nm); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace CustomaryLiterals
+{
+
+METAMEASURE_CUSTOMARY_LENGTH_LITERALS;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef METAMEASURE_UNITS_SI_INCLUDED
+#define METAMEASURE_UNITS_SI_INCLUDED
+
+// All of the SI base units, with every metric prefix
+// Include the headers in MetaMeasure/Units/SI/ directly if you only need some of them
+
+#include <MetaMeasure/Units/SI/Length.hpp>
+#include <MetaMeasure/Units/SI/Mass.hpp>
+#include <MetaMeasure/Units/SI/Time.hpp>
+#include <MetaMeasure/Units/SI/Temperature.hpp>
+#include <MetaMeasure/Units/SI/Current.hpp>
+#include <MetaMeasure/Units/SI/Luminosity.hpp>
+#include <MetaMeasure/Units/SI/SubstanceQuantity.hpp>
+
+// Every SI literal, for use in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_LITERALS \
+METAMEASURE_SI_LENGTH_LITERALS; \
+METAMEASURE_SI_MASS_LITERALS; \
+METAMEASURE_SI_TIME_LITERALS; \
+METAMEASURE_SI_TEMPERATURE_LITERALS; \
+METAMEASURE_SI_CURRENT_LITERALS; \
+METAMEASURE_SI_LUMINOSITY_LITERALS; \
+METAMEASURE_SI_SUBSTANCEQUANTITY_LITERALS; \
+METAMEASURE_FORCE_SEMICOLON
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef METAMEASURE_UNITS_SI_CURRENT_INCLUDED
+#define METAMEASURE_UNITS_SI_CURRENT_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// SI base unit for current; ratios are relative to this
+METAMEASURE_UNIT(Amperes, Current, 1, 1);
+METAMEASURE_UNIT_WITH_METRIC_PREFIXES(amperes, Current, 1, 1);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_CURRENT_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Amperes, 1, _A); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, amperes, 1, A); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace MetricLiterals
+{
+
+METAMEASURE_SI_CURRENT_LITERALS;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef METAMEASURE_UNITS_SI_LENGTH_INCLUDED
+#define METAMEASURE_UNITS_SI_LENGTH_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// SI base unit for length; ratios are relative to this
+METAMEASURE_UNIT(Meters, Length, 1, 1);
+METAMEASURE_UNIT_WITH_METRIC_PREFIXES(meters, Length, 1, 1);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_LENGTH_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Meters, 1, _m); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, meters, 1, m); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace MetricLiterals
+{
+
+METAMEASURE_SI_LENGTH_LITERALS;
+
+}
+
+}
+
+#endif
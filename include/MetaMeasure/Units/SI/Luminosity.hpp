@@ -0,0 +1,28 @@
+#ifndef METAMEASURE_UNITS_SI_LUMINOSITY_INCLUDED
+#define METAMEASURE_UNITS_SI_LUMINOSITY_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// SI base unit for luminosity; ratios are relative to this
+METAMEASURE_UNIT(Candelas, Luminosity, 1, 1);
+METAMEASURE_UNIT_WITH_METRIC_PREFIXES(candelas, Luminosity, 1, 1);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_LUMINOSITY_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Candelas, 1, _cd); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, candelas, 1, cd); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace MetricLiterals
+{
+
+METAMEASURE_SI_LUMINOSITY_LITERALS;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef METAMEASURE_UNITS_SI_MASS_INCLUDED
+#define METAMEASURE_UNITS_SI_MASS_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// SI base unit for mass; ratios are relative to this
+// I'm aware the base unit for mass is actually kilograms, but for the sake of simplicity, I'm using grams.
+// It wouldn't be nice to use std::nano to describe the ratio between micrograms and kilograms, would it?
+METAMEASURE_UNIT(Grams, Mass, 1, 1);
+METAMEASURE_UNIT_WITH_METRIC_PREFIXES(grams, Mass, 1, 1);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_MASS_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Grams, 1, _g); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, grams, 1, g); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace MetricLiterals
+{
+
+METAMEASURE_SI_MASS_LITERALS;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef METAMEASURE_UNITS_SI_SUBSTANCEQUANTITY_INCLUDED
+#define METAMEASURE_UNITS_SI_SUBSTANCEQUANTITY_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// SI base unit for amount of substance; ratios are relative to this
+METAMEASURE_UNIT(Moles, SubstanceQuantity, 1, 1);
+METAMEASURE_UNIT_WITH_METRIC_PREFIXES(moles, SubstanceQuantity, 1, 1);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_SUBSTANCEQUANTITY_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Moles, 1, _mol); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, moles, 1, mol); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace MetricLiterals
+{
+
+METAMEASURE_SI_SUBSTANCEQUANTITY_LITERALS;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef METAMEASURE_UNITS_SI_TEMPERATURE_INCLUDED
+#define METAMEASURE_UNITS_SI_TEMPERATURE_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// SI base unit for temperature; ratios are relative to this
+METAMEASURE_UNIT(Kelvins, Temperature, 1, 1);
+METAMEASURE_UNIT_WITH_METRIC_PREFIXES(kelvins, Temperature, 1, 1);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_TEMPERATURE_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Kelvins, 1, _K); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, kelvins, 1, K); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace MetricLiterals
+{
+
+METAMEASURE_SI_TEMPERATURE_LITERALS;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef METAMEASURE_UNITS_SI_TIME_INCLUDED
+#define METAMEASURE_UNITS_SI_TIME_INCLUDED
+
+#include <MetaMeasure/Literals.hpp>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+// SI base unit for time; ratios are relative to this
+METAMEASURE_UNIT(Seconds, Time, 1, 1);
+METAMEASURE_UNIT_WITH_METRIC_PREFIXES(seconds, Time, 1, 1);
+
+// Every literal in this header, so they can also be put in a namespace with its own MetaMeasureLiteralMode
+#define METAMEASURE_SI_TIME_LITERALS \
+METAMEASURE_LITERAL(MetaMeasure::Seconds, 1, _s); \
+METAMEASURE_LITERAL(MetaMeasure::Seconds, -1, _Hz); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, seconds, 1, s); \
+METAMEASURE_LITERAL_WITH_METRIC_PREFIXES_IN(MetaMeasure::, seconds, -1, Hz); \
+METAMEASURE_FORCE_SEMICOLON
+
+namespace MetricLiterals
+{
+
+METAMEASURE_SI_TIME_LITERALS;
+
+}
+
+}
+
+#endif
@@ -3,15 +3,14 @@
 
 #include <MetaMeasure/UnitBase.hpp>
 
-#include <tuple>
+#include <cstdint>
+#include <limits>
 #include <ratio>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
-// This is for compilers that warn about extra semi-colons, even though they're perfectly legal
-#define METAMEASURE_FORCE_SEMICOLON \
-extern void* MetaMeasureSemicolonForcer_
-
-namespace MetaMeasure
+METAMEASURE_EXPORT namespace MetaMeasure
 {
 
 // Helper ratio
@@ -19,398 +18,392 @@ using OneToOne = std::ratio<1, 1>;
 
 namespace Private
 {
-// Gets the exponent of a unit's dimension
-template<typename T>
-struct ExponentOf
-{
-  static constexpr ExponentType Value = T::Dimension::Exponent;
-};
-
-// Evaluates to the tuple that's larger
-template<typename Tuple, typename Tuple2>
-using LargerTuple = std::conditional_t
-<
-  (std::tuple_size<Tuple>::value < std::tuple_size<Tuple2>::value),
-  Tuple2,
-  Tuple
->;
-
-// Evaluates to the tuple that's smaller
-template<typename Tuple, typename Tuple2>
-using SmallerTuple = std::conditional_t
-<
-  (std::tuple_size<Tuple>::value < std::tuple_size<Tuple2>::value),
-  Tuple,
-  Tuple2
->;
-
-// Convert tuple of units to tuple of dimensions
-template<typename Tuple>
-struct DimensionsTuple_;
-
-template<typename... Units>
-struct DimensionsTuple_<std::tuple<Units...>>
-{
-  using Type = std::tuple<typename Units::Dimension...>;
-};
-
-template<typename Tuple>
-using DimensionsTuple = typename DimensionsTuple_<Tuple>::Type;
-
-// Convert tuple of units to tuple of dimension identifiers
-template<typename Tuple>
-struct IdentifierTuple_;
-
-template<typename... Units>
-struct IdentifierTuple_<std::tuple<Units...>>
-{
-  using Type = std::tuple<typename Units::Dimension::Identifier...>;
-};
-
-template<typename Tuple>
-using IdentifierTuple = typename IdentifierTuple_<Tuple>::Type;
-
-// Checks if a parameter pack has a type in it
-template<typename T, typename...>
-struct HasType;
-
-template<typename T>
-struct HasType<T> : std::false_type {};
-
-template<typename T, typename U, typename... Ts>
-struct HasType<T, U, Ts...> : std::conditional_t
-<
-  std::is_same_v<T, U>,
-  std::true_type,
-  HasType<T, Ts...>
-> {};
 
-// Check if Tuple2 only has types Tuple has
-template<typename Tuple, typename Tuple2>
-struct SharesTypes_;
-
-template<typename... Ts>
-struct SharesTypes_<std::tuple<Ts...>, std::tuple<>> : std::true_type {};
-
-template<typename... Ts, typename U, typename... Us>
-struct SharesTypes_<std::tuple<Ts...>, std::tuple<U, Us...>> : std::conditional_t
-<
-  HasType<U, Ts...>::value,
-  SharesTypes_<std::tuple<Ts...>, std::tuple<Us...>>,
-  std::false_type
-> {};
-
-template<typename Tuple, typename Tuple2>
-using SharesTypes = SharesTypes_
-<
-  LargerTuple<Tuple, Tuple2>,
-  SmallerTuple<Tuple, Tuple2>
->;
-
-template<typename Tuple, typename Tuple2>
-using IdenticalTypes = SharesTypes_
-<
-  SmallerTuple<Tuple, Tuple2>,
-  LargerTuple<Tuple, Tuple2>
->;
-
-// Checks if Tuple and Tuple2 share dimensions
-template<typename Tuple, typename Tuple2>
-struct SharesDimensions : SharesTypes
-<
-  DimensionsTuple<Tuple>,
-  DimensionsTuple<Tuple2>
-> {};
-
-// Checks if Tuple and Tuple2 have the same exact dimensions
-template<typename Tuple, typename Tuple2>
-struct IdenticalDimensions : IdenticalTypes
-<
-  DimensionsTuple<Tuple>,
-  DimensionsTuple<Tuple2>
-> {};
+// The integer type rationals and intermediate results are kept in
+// 128 bits holds cubes of customary units in nanometers, Yotta and Yocto prefixes,
+// And the product of any 64-bit value and any 64-bit ratio.
+// The standard type traits don't know about __int128 in strict mode, so don't use them on these.
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 WideInteger;
+__extension__ typedef unsigned __int128 WideUnsigned;
+#else
+using WideInteger = std::intmax_t;
+using WideUnsigned = std::uintmax_t;
+#endif
 
-// Checks if parameter pack has exactly one of a type
-template<typename...>
-struct HasOneOf;
+inline constexpr WideInteger WideIntegerMax = static_cast<WideInteger>(~static_cast<WideUnsigned>(0) >> 1);
 
-template<typename T>
-struct HasOneOf<T>
+// std::gcd doesn't take __int128 in strict mode, so this is our own
+constexpr WideInteger gcd(WideInteger a, WideInteger b)
 {
-  static constexpr bool Value = false;
-};
-
-template<typename T, typename U, typename... Ts>
-struct HasOneOf<T, U, Ts...>
-{
-  static constexpr bool Value = std::is_same_v<T, U>
-    || HasOneOf<T, Ts...>::Value;
-};
+  if (a < 0) a = -a;
+  if (b < 0) b = -b;
 
-// Checks if Tuple has no duplicated dimensions at all
-template<typename Tuple>
-struct HasNoDuplicates;
+  while (b != 0)
+  {
+    WideInteger t = a % b;
+    a = b;
+    b = t;
+  }
 
-template<>
-struct HasNoDuplicates<std::tuple<>>
-{
-  static constexpr bool Value = true;
-};
+  return a;
+}
 
-template<typename T, typename... Ts>
-struct HasNoDuplicates<std::tuple<T, Ts...>>
-{
-  static constexpr bool Value = HasNoDuplicates<std::tuple<Ts...>>::Value &&
-    !HasOneOf
-    <
-      typename T::Dimension::Identifier,
-      typename Ts::Dimension::Identifier...
-    >::Value;
-};
+// Not constexpr on purpose: calling it while evaluating a constant is a compile error that names the problem
+inline void rationalOverflowed() {}
+inline void fractionalExponent() {}
 
-// Calculates the reciprocal of a ratio
-template<typename Ratio>
-struct Reciprocal_
+// Multiplies 2 integers, failing to compile if the result doesn't fit
+constexpr WideInteger checkedMultiply(WideInteger a, WideInteger b)
 {
-private:
-  using R = Ratio;
+  WideInteger absA = a < 0 ? -a : a;
+  WideInteger absB = b < 0 ? -b : b;
 
-public:
-  using Type = std::ratio<R::den, R::num>;
-};
+  if (absA != 0 && absB > WideIntegerMax / absA)
+  {
+    Private::rationalOverflowed();
+  }
 
-template<typename Ratio>
-using Reciprocal = typename Reciprocal_<Ratio>::Type;
+  return a * b;
+}
 
-// Calculates the unit's ratio to the base unit, accounting for the degree of the unit
-// When I say accounting for degree: there are 1000 m in 1 km, and 1000000 m in 1 km
-// The ratio changes with the degree
-template<typename T, typename = std::true_type>
-struct UnitRatio_;
+}
 
-template<typename T>
-struct UnitRatio_<T, std::integral_constant<bool, (ExponentOf<T>::Value == 0)>>
+// A rational number that's a value instead of a type like std::ratio
+// Doing arithmetic on it is just a constexpr function call, so nothing gets instantiated
+// It holds 128-bit integers where the compiler has them, so chains of ratios that overflow std::ratio still fold to 1 constant.
+struct Rational
 {
-  using Type = OneToOne;
+  Private::WideInteger num = 1;
+  Private::WideInteger den = 1;
+
+  constexpr Rational() = default;
+
+  constexpr Rational(Private::WideInteger numerator, Private::WideInteger denominator = 1)
+    : num(numerator), den(denominator)
+  {
+    // Keep the sign on the numerator and the fraction reduced,
+    // That way equal ratios always compare equal member by member
+    if (this->den < 0)
+    {
+      this->num = -this->num;
+      this->den = -this->den;
+    }
+
+    Private::WideInteger divisor = Private::gcd(this->num, this->den);
+    if (divisor > 1)
+    {
+      this->num /= divisor;
+      this->den /= divisor;
+    }
+  }
+
+  // From std::ratio, or anything else with num and den members (like RatioOf)
+  template<typename RatioT, typename = decltype(RatioT::num + RatioT::den)>
+  constexpr Rational(RatioT)
+    : Rational(RatioT::num, RatioT::den)
+  {}
+
+  friend constexpr Rational operator*(const Rational& l, const Rational& r)
+  {
+    // Cross reduce first, so we only overflow when the result itself doesn't fit
+    Private::WideInteger a = Private::gcd(l.num, r.den);
+    Private::WideInteger b = Private::gcd(r.num, l.den);
+    if (a == 0) a = 1;
+    if (b == 0) b = 1;
+
+    return Rational(Private::checkedMultiply(l.num / a, r.num / b), Private::checkedMultiply(l.den / b, r.den / a));
+  }
+
+  friend constexpr Rational operator/(const Rational& l, const Rational& r)
+  {
+    return l * Rational(r.den, r.num);
+  }
+
+  friend constexpr bool operator==(const Rational&, const Rational&) = default;
 };
 
-template<typename T>
-struct UnitRatio_<T, std::integral_constant<bool, (ExponentOf<T>::Value > 0)>>
+// Raises a ratio to an integer power
+// This squares as it goes, so it takes log2(exponent) steps
+constexpr Rational pow(Rational base, ExponentType exponent)
 {
-private:
-  using NextDimension = Dimension<typename T::Dimension::Identifier, (ExponentOf<T>::Value - 1)>;
-  using Ratio = typename T::Ratio;
-  using NextUnit = Unit<NextDimension, Ratio>;
-
-public:
-  // Multiply the ratio by itself until the degree is 0. Basic exponentation, but done recursively.
-  using Type = std::ratio_multiply<Ratio, typename UnitRatio_<NextUnit>::Type>;
-};
+  Rational result;
+
+  if (exponent < 0)
+  {
+    base = Rational(base.den, base.num);
+    exponent = -exponent;
+  }
+
+  while (exponent > 0)
+  {
+    if (exponent & 1)
+    {
+      result = result * base;
+    }
+
+    exponent >>= 1;
+    if (exponent > 0)
+    {
+      base = base * base;
+    }
+  }
+
+  return result;
+}
 
-template<typename T>
-struct UnitRatio_<T, std::integral_constant<bool, (ExponentOf<T>::Value < 0)>>
+// A rational as a type, for units whose ratio doesn't fit in a std::ratio (like Yotta and Yocto prefixes)
+template<Rational RatioV>
+struct RatioOf
 {
-private:
-  using NextDimension = Dimension<typename T::Dimension::Identifier, (-ExponentOf<T>::Value)>;
-  using Ratio = typename T::Ratio;
-  using NextUnit = Unit<NextDimension, Ratio>;
-
-public:
-  // Since x^(-y) is really the reciprocal of x^y, we calculate x^y and then take the reciprocal
-  using Type = Reciprocal<typename UnitRatio_<NextUnit>::Type>;
+  static constexpr Private::WideInteger num = RatioV.num;
+  static constexpr Private::WideInteger den = RatioV.den;
 };
 
-template<typename T>
-using UnitRatio = typename UnitRatio_<T>::Type;
-
-// Calculates the overall ratio of a measurement, which will be used for conversions
-// Instead of converting each unit individually, we can do it all at once with this ratio
-template<typename Tuple>
-struct OverallRatio_;
-
-template<typename T, typename U, typename... Ts>
-struct OverallRatio_<std::tuple<T, U, Ts...>>
+// What a measurement's units boil down to: the exponent of each of the 7 dimensions,
+// The ratio of the unit used for each dimension to its base unit,
+// And the ratio of the whole measurement to base units (which is what conversions use).
+// This is a value, so it can be used as a template parameter and worked on with plain constexpr functions.
+// Multiplying 2 of these is a loop over 7 numbers, instead of a recursive template for every pair of units.
+struct DimensionVector
 {
-  using Type = std::ratio_multiply
-  <
-    std::ratio_multiply<UnitRatio<T>, UnitRatio<U>>,
-    typename OverallRatio_<std::tuple<Ts...>>::Type
-  >;
+  // Every element is spelled out on purpose
+  // Some compilers (GCC 12 at least) treat vectors that are only different past a {} initializer as the same template argument
+  ExponentType exponents[DimensionCount] = {0, 0, 0, 0, 0, 0, 0};
+  Rational scales[DimensionCount] = {1, 1, 1, 1, 1, 1, 1};
+  Rational ratio = {};
+
+  // Checks if there are no dimensions at all
+  constexpr bool dimensionless() const
+  {
+    for (ExponentType e : this->exponents)
+    {
+      if (e != 0) return false;
+    }
+
+    return true;
+  }
+
+  // Checks if the dimensions are the same, ignoring which units they're measured in
+  constexpr bool sameDimensions(const DimensionVector& other) const
+  {
+    for (std::size_t i = 0; i < DimensionCount; ++i)
+    {
+      if (this->exponents[i] != other.exponents[i]) return false;
+    }
+
+    return true;
+  }
+
+  // Resets the unit of any dimension with degree 0 and recalculates the overall ratio
+  // Every operation does this last, so equal measurements have equal vectors
+  constexpr DimensionVector& normalize()
+  {
+    this->ratio = Rational();
+
+    for (std::size_t i = 0; i < DimensionCount; ++i)
+    {
+      if (this->exponents[i] == 0)
+      {
+        this->scales[i] = Rational();
+      }
+
+      this->ratio = this->ratio * MetaMeasure::pow(this->scales[i], this->exponents[i]);
+    }
+
+    return *this;
+  }
+
+  // Dimensions that both vectors have keep the units of the left one
+  friend constexpr DimensionVector operator*(const DimensionVector& l, const DimensionVector& r)
+  {
+    DimensionVector result = l;
+
+    for (std::size_t i = 0; i < DimensionCount; ++i)
+    {
+      if (l.exponents[i] == 0)
+      {
+        result.scales[i] = r.scales[i];
+      }
+
+      result.exponents[i] += r.exponents[i];
+    }
+
+    return result.normalize();
+  }
+
+  friend constexpr DimensionVector operator/(const DimensionVector& l, const DimensionVector& r)
+  {
+    return l * r.reciprocal();
+  }
+
+  // Take the reciprocal of the dimensions
+  // For instance, time (s) becomes 1/time (Hz)
+  constexpr DimensionVector reciprocal() const
+  {
+    DimensionVector result = *this;
+
+    for (ExponentType& e : result.exponents)
+    {
+      e = -e;
+    }
+
+    return result.normalize();
+  }
+
+  // Checks if raising the dimensions to the power of num/den leaves every exponent whole
+  constexpr bool hasPower(ExponentType num, ExponentType den = 1) const
+  {
+    if (den <= 0) return false;
+
+    for (ExponentType e : this->exponents)
+    {
+      if ((e * num) % den != 0) return false;
+    }
+
+    return true;
+  }
+
+  // Raise the dimensions to the power of num/den, keeping their units
+  // For instance, the square root (1/2) of area (m^2) is length (m).
+  // There's no such thing as m^(1/2), so this fails to compile unless hasPower(num, den).
+  constexpr DimensionVector power(ExponentType num, ExponentType den = 1) const
+  {
+    if (!this->hasPower(num, den))
+    {
+      Private::fractionalExponent();
+    }
+
+    DimensionVector result = *this;
+
+    for (ExponentType& e : result.exponents)
+    {
+      e = e * num / den;
+    }
+
+    return result.normalize();
+  }
+
+  friend constexpr bool operator==(const DimensionVector&, const DimensionVector&) = default;
 };
 
-template<typename T, typename U>
-struct OverallRatio_<std::tuple<T, U>>
+namespace Private
 {
-  using Type = std::ratio_multiply<UnitRatio<T>, UnitRatio<U>>;
-};
 
+// Adds a single unit to a dimension vector
+// Units of degree 0 don't contribute anything, so they're skipped
 template<typename T>
-struct OverallRatio_<std::tuple<T>>
+constexpr void addUnit(DimensionVector& dimensions)
 {
-  using Type = UnitRatio<T>;
-};
-
-template<typename Tuple>
-using OverallRatio = typename OverallRatio_<Tuple>::Type;
-
-template<typename UnitTuple, typename UnitTuple2>
-using ConversionRatio = std::ratio_divide<OverallRatio<UnitTuple>, OverallRatio<UnitTuple2>>;
-
-// The result of a tuple concatenation
-template<typename... Ts>
-using TupleCat = decltype(std::tuple_cat(std::declval<Ts>()...));
-
-// Removes all dimensions that have degree 0 in Tuple
-template<typename Tuple>
-struct RemoveZeroDimensions_;
+  constexpr std::size_t Index = DimensionIndex<typename T::Dimension::Identifier>::Value;
 
-template<>
-struct RemoveZeroDimensions_<std::tuple<>>
-{
-  using Type = std::tuple<>;
-};
+  if constexpr (T::Dimension::Exponent != 0)
+  {
+    dimensions.exponents[Index] = T::Dimension::Exponent;
+    dimensions.scales[Index] = Rational(typename T::Ratio());
+  }
+}
 
-template<typename T, typename... Ts>
-struct RemoveZeroDimensions_<std::tuple<T, Ts...>>
+// Checks if a list of units has no duplicated dimensions at all
+// Like addUnit, units of degree 0 are ignored
+template<typename... Units>
+constexpr bool hasNoDuplicates()
 {
-  using Type = TupleCat
-  <
-    std::conditional_t
-    <
-      (ExponentOf<T>::Value == 0),
-      std::tuple<>,
-      std::tuple<T>
-    >,
-    typename RemoveZeroDimensions_<std::tuple<Ts...>>::Type
-  >;
-};
+  std::size_t counts[DimensionCount] = {};
+  ((counts[DimensionIndex<typename Units::Dimension::Identifier>::Value] += (Units::Dimension::Exponent != 0)), ...);
 
-template<typename Tuple>
-using RemoveZeroDimensions = typename RemoveZeroDimensions_<Tuple>::Type;
+  for (std::size_t count : counts)
+  {
+    if (count > 1) return false;
+  }
 
-// Take the reciprocal of the dimensions
-// For instance, time (s) becomes 1/time (Hz)
-template<typename Tuple>
-struct ReciprocalDimensions_;
+  return true;
+}
 
-template<>
-struct ReciprocalDimensions_<std::tuple<>>
+// Lowers a list of units into the dimension vector they describe
+template<typename... Units>
+constexpr DimensionVector dimensionsOf()
 {
-  using Type = std::tuple<>;
-};
+  // An example of something that would cause this error
+  // Would be specifying inches & meters in the parameter pack.
+  // Another example would be specifying seconds and hertz.
+  static_assert(Private::hasNoDuplicates<Units...>(),
+                "Measurement has 2 or more units of the same dimension.");
+
+  DimensionVector dimensions;
+  (Private::addUnit<Units>(dimensions), ...);
+  return dimensions.normalize();
+}
 
-template<typename T, typename... Ts>
-struct ReciprocalDimensions_<std::tuple<T, Ts...>>
+// Checks if a rational fits in a std::ratio
+constexpr bool fitsInRatio(const Rational& r)
 {
-private:
-  using FlippedDimension = Dimension<typename T::Dimension::Identifier, (-ExponentOf<T>::Value)>;
-  using FlippedUnit = Unit<FlippedDimension, typename T::Ratio>;
-
-public:
-  using Type = TupleCat
-  <
-    std::tuple<FlippedUnit>,
-    typename ReciprocalDimensions_<std::tuple<Ts...>>::Type
-  >;
-};
+  constexpr WideInteger Max = std::numeric_limits<std::intmax_t>::max();
+  return r.num <= Max && -r.num <= Max && r.den <= Max;
+}
 
-template<typename Tuple>
-using ReciprocalDimensions = typename ReciprocalDimensions_<Tuple>::Type;
+// The type a rational is written as in a unit: a std::ratio if it fits in one, RatioOf otherwise
+template<Rational RatioV>
+using RatioType = std::conditional_t
+<
+  Private::fitsInRatio(RatioV),
+  std::ratio<static_cast<std::intmax_t>(Private::fitsInRatio(RatioV) ? RatioV.num : 1),
+             static_cast<std::intmax_t>(Private::fitsInRatio(RatioV) ? RatioV.den : 1)>,
+  RatioOf<RatioV>
+>;
 
-// Multiplies a single dimension from Tuple by T
-template<typename Tuple, typename T>
-struct MultiplyDimension_;
+// Raises a dimension vector back into the unit used for one of its dimensions
+template<DimensionVector DimensionsV, std::size_t Index>
+using UnitAt = Unit
+<
+  Dimension<std::tuple_element_t<Index, DimensionOrder>, DimensionsV.exponents[Index]>,
+  RatioType<DimensionsV.scales[Index]>
+>;
 
-template<typename T>
-struct MultiplyDimension_<std::tuple<>, T>
-{
-  using Type = std::tuple<>;
-};
+// Raises a dimension vector back into a tuple of units
+// Dimensions of degree 0 are left out, and the rest are sorted by DimensionOrder
+template<DimensionVector DimensionsV, typename Sequence = std::make_index_sequence<DimensionCount>>
+struct UnitTuple_;
 
-template<typename T, typename U, typename... Us>
-struct MultiplyDimension_<std::tuple<U, Us...>, T>
+template<DimensionVector DimensionsV, std::size_t... Indices>
+struct UnitTuple_<DimensionsV, std::index_sequence<Indices...>>
 {
-private:
-  static constexpr bool SameDimension = std::is_same_v
-  <
-    typename T::Dimension::Identifier,
-    typename U::Dimension::Identifier
-  >;
-
-  using MultipliedDimension = Dimension
-  <
-    typename T::Dimension::Identifier,
-    (ExponentOf<T>::Value + ExponentOf<U>::Value)
-  >;
-
-  using MultipliedUnit = Unit
-  <
-    MultipliedDimension,
-    typename T::Ratio
-  >;
-
-public:
-  using Type = TupleCat
+  using Type = decltype(std::tuple_cat(std::declval
   <
     std::conditional_t
     <
-      SameDimension,
-      std::tuple<MultipliedUnit>,
-      std::tuple<U>
-    >,
-    typename MultiplyDimension_<std::tuple<Us...>, T>::Type
-  >;
+      (DimensionsV.exponents[Indices] == 0),
+      std::tuple<>,
+      std::tuple<UnitAt<DimensionsV, Indices>>
+    >
+  >()...));
 };
 
-template<typename Tuple, typename T>
-using MultiplyDimension = typename MultiplyDimension_<Tuple, T>::Type;
+template<DimensionVector DimensionsV>
+using UnitTuple = typename UnitTuple_<DimensionsV>::Type;
 
-// Multiplies Tuple's dimensions by Tuple2's dimensions
-template<typename Tuple, typename Tuple2>
-struct MultiplyDimensions_;
+// Checks if 2 measurements have the same exact units
+// Dimension vectors are normalized, so this compares 2 values without instantiating either unit tuple.
+template<typename M, typename M2>
+using IdenticalTypes = std::bool_constant<M::Dimensions == M2::Dimensions>;
 
-template<typename... Ts>
-struct MultiplyDimensions_ <std::tuple<Ts...>, std::tuple<>>
-{
-  using Type = std::tuple<Ts...>;
-};
-
-template<typename... Ts, typename U, typename... Us>
-struct MultiplyDimensions_<std::tuple<Ts...>, std::tuple<U, Us...>>
-{
-private:
-  static constexpr bool TupleHasDimension = HasType
-  <
-    typename U::Dimension::Identifier,
-    typename Ts::Dimension::Identifier...
-  >::value;
+// Checks if 2 measurements have the same dimensions, even if their units differ
+template<typename M, typename M2>
+using IdenticalDimensions = std::bool_constant<M::Dimensions.sameDimensions(M2::Dimensions)>;
 
-public:
-  using Type = typename MultiplyDimensions_
-  <
-    std::conditional_t
-    <
-      TupleHasDimension,
-      MultiplyDimension<std::tuple<Ts...>, U>,
-      TupleCat<std::tuple<Ts...>, std::tuple<U>>
-    >,
-    std::tuple<Us...>
-  >::Type;
-};
+// The ratio that converts a value in From's units into To's units
+// Ratios count how many of a unit fit in the base unit, so this is To over From
+template<DimensionVector From, DimensionVector To>
+inline constexpr Rational ConversionRatio = To.ratio / From.ratio;
 
-template<typename Tuple, typename Tuple2>
-using MultiplyDimensions = RemoveZeroDimensions
-<
-  typename MultiplyDimensions_
-  <
-    LargerTuple<Tuple, Tuple2>,
-    SmallerTuple<Tuple, Tuple2>
-  >::Type
->;
+// The ratio the product of 2 values has to be scaled by to be in the units of L * R
+// This is 1 unless both sides have a dimension in different units
+template<DimensionVector L, DimensionVector R>
+inline constexpr Rational ProductRatio = (L * R).ratio / (L.ratio * R.ratio);
 
-// Divides Tuple's dimensions by Tuple2's dimensions
-template<typename Tuple, typename Tuple2>
-using DivideDimensions = MultiplyDimensions<Tuple, ReciprocalDimensions<Tuple2>>;
+// Same as ProductRatio, but for the quotient of 2 values
+template<DimensionVector L, DimensionVector R>
+inline constexpr Rational QuotientRatio = (L / R).ratio / (L.ratio / R.ratio);
 
 }
 
@@ -0,0 +1,585 @@
+#ifndef METAMEASURE_VECTOR_INCLUDED
+#define METAMEASURE_VECTOR_INCLUDED
+
+// Small vectors of measurements, like a position in meters or a force in newtons
+// The components are bare numbers in one aligned block that's padded to a power of 2,
+// So a Vec3 of floats is 16 bytes the compiler can load and add as a single SIMD register.
+// The units are only in the type: dot() of 2 vectors of meters gives square meters,
+// And scaling by a measurement gives a vector in the units of the product or quotient.
+// Many vectors at once go in a VectorBatch, which keeps each component in its own MeasurementArray (structure of arrays),
+// So loops over them vectorize across vectors instead of within one.
+
+#include <MetaMeasure/Array.hpp>
+#include <MetaMeasure/Math.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+METAMEASURE_EXPORT namespace MetaMeasure
+{
+
+template<typename NumT, DimensionVector DimensionsV, std::size_t N>
+class BasicMeasurementVector;
+
+template<typename NumT, DimensionVector DimensionsV, std::size_t N, typename AllocatorT = AlignedAllocator<NumT>>
+class BasicVectorBatch;
+
+// A vector of N measurements in the given units
+// Like Measurement, this lowers the units into a DimensionVector.
+template<typename NumT, std::size_t N, typename... Units>
+using MeasurementVector = BasicMeasurementVector<NumT, Private::dimensionsOf<Units...>(), N>;
+
+namespace Private
+{
+
+template<typename NumT, DimensionVector DimensionsV, std::size_t N>
+struct IsMeasurementVector<BasicMeasurementVector<NumT, DimensionsV, N>> : std::true_type {};
+
+// How a vector of N NumTs is laid out
+// It's padded to a power of 2 and aligned to its whole size (up to a cache line), so it's never split across 2 loads.
+template<typename NumT, std::size_t N>
+struct VectorLayout
+{
+  static constexpr std::size_t Lanes = std::bit_ceil(N);
+  static constexpr std::size_t Bytes = Lanes * sizeof(NumT);
+  static constexpr std::size_t Alignment = std::has_single_bit(Bytes) && Bytes <= CacheLineSize ? Bytes : alignof(NumT);
+};
+
+// The vector with N components of type T
+// Components without dimensions are plain numbers, so they make a dimensionless vector
+template<typename T, std::size_t N, bool = IsMeasurement<T>::value>
+struct VectorOf_
+{
+  using Type = BasicMeasurementVector<T, DimensionVector{}, N>;
+};
+
+template<typename M, std::size_t N>
+struct VectorOf_<M, N, true>
+{
+  using Type = BasicMeasurementVector<typename M::ValueType, M::Dimensions, N>;
+};
+
+template<typename T, std::size_t N>
+using VectorOf = typename VectorOf_<T, N>::Type;
+
+// The batch of vectors with N components of type M
+template<typename M, std::size_t N>
+struct BatchOf_
+{
+  using Type = BasicVectorBatch<typename M::ValueType, M::Dimensions, N>;
+};
+
+// The type a measurement, or a plain number, keeps its value in
+template<typename T>
+using BareValueType = decltype(Private::bareValue(std::declval<const T&>()));
+
+}
+
+// A vector of N measurements in a DimensionVector's units
+// Every component has the same units; reading one gives back a measurement (or a plain number if there are no dimensions).
+template<typename NumT, DimensionVector DimensionsV, std::size_t N>
+class BasicMeasurementVector
+{
+  static_assert(N > 0, "A vector needs at least 1 component.");
+
+public:
+  using ValueType = NumT;
+  static constexpr DimensionVector Dimensions = DimensionsV;
+  static constexpr std::size_t Size = N;
+
+  // What a single component is read as
+  using Element = Private::MeasurementFromDimensions<NumT, DimensionsV>;
+
+private:
+  using ThisType = BasicMeasurementVector<NumT, DimensionsV, N>;
+  using Layout = Private::VectorLayout<NumT, N>;
+
+  // Element-wise operators go over every lane, padding included, so the compiler sees whole registers
+  // The padding starts at 0 and every one of them keeps it there; reductions and comparisons only go over the N components.
+  static constexpr std::size_t Lanes = Layout::Lanes;
+
+  // If the type is a vector of the same size and dimensions, overloads that use this type may be called
+  template<typename V, typename T = int>
+  using IfConvertibleVector = std::enable_if_t
+  <
+    Private::IsMeasurementVector<V>::value && V::Size == N && Private::IdenticalDimensions<ThisType, V>::value,
+    T
+  >;
+
+  // If the type is a measurement, overloads that use this type may be called
+  template<typename M, typename T = long>
+  using IfMeasurement = std::enable_if_t<Private::IsMeasurement<M>::value, T>;
+
+  // A plain number, rather than a measurement of any sort
+  template<typename U, typename T = char>
+  using IfScalar = std::enable_if_t<Private::IsScalar<U>::value, T>;
+
+public:
+  constexpr BasicMeasurementVector() = default;
+
+  // Takes every component, converting them into this vector's units
+  template<typename... Components,
+           std::enable_if_t<sizeof...(Components) == N && (std::is_convertible_v<const Components&, Element> && ...), int> = 0>
+  constexpr BasicMeasurementVector(const Components&... components)
+    : v{Private::bareValue(Element(components))...}
+  {}
+
+  // Converts a vector with the same dimensions into this one's units
+  template<typename V, IfConvertibleVector<V> = 0>
+  constexpr BasicMeasurementVector(const V& other)
+  {
+    for (std::size_t i = 0; i < N; ++i) this->v[i] = Private::bareValue(Element(other[i]));
+  }
+
+  // A vector of bare values that are already in this vector's units
+  static constexpr ThisType fromValues(const std::array<NumT, N>& values)
+  {
+    ThisType result;
+    for (std::size_t i = 0; i < N; ++i) result.v[i] = values[i];
+    return result;
+  }
+
+  constexpr Element operator[](std::size_t i) const { return Element(this->v[i]); }
+
+  constexpr Element x() const requires (N >= 1) { return Element(this->v[0]); }
+  constexpr Element y() const requires (N >= 2) { return Element(this->v[1]); }
+  constexpr Element z() const requires (N >= 3) { return Element(this->v[2]); }
+  constexpr Element w() const requires (N >= 4) { return Element(this->v[3]); }
+
+  // Sets a component, converting it into this vector's units
+  template<typename M, std::enable_if_t<std::is_convertible_v<const M&, Element>, int> = 0>
+  constexpr void set(std::size_t i, const M& component)
+  {
+    this->v[i] = Private::bareValue(Element(component));
+  }
+
+  // The bare values, in this vector's units
+  constexpr NumT* data() { return std::assume_aligned<Layout::Alignment>(this->v); }
+  constexpr const NumT* data() const { return std::assume_aligned<Layout::Alignment>(this->v); }
+
+  constexpr std::span<NumT, N> values() { return std::span<NumT, N>(this->data(), N); }
+  constexpr std::span<const NumT, N> values() const { return std::span<const NumT, N>(this->data(), N); }
+
+  // Arithmetic operators
+  constexpr ThisType operator-() const
+  {
+    ThisType result;
+    for (std::size_t i = 0; i < Lanes; ++i) result.v[i] = -this->v[i];
+    return result;
+  }
+
+  template<typename V, IfConvertibleVector<V> = 0>
+  constexpr ThisType operator+(const V& other) const
+  {
+    ThisType result(other);
+    for (std::size_t i = 0; i < Lanes; ++i) result.v[i] = this->v[i] + result.v[i];
+    return result;
+  }
+
+  template<typename V, IfConvertibleVector<V> = 0>
+  constexpr ThisType operator-(const V& other) const
+  {
+    ThisType result(other);
+    for (std::size_t i = 0; i < Lanes; ++i) result.v[i] = this->v[i] - result.v[i];
+    return result;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType operator*(const NumU& factor) const
+  {
+    ThisType result;
+    for (std::size_t i = 0; i < Lanes; ++i) result.v[i] = this->v[i] * factor;
+    return result;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  friend constexpr ThisType operator*(const NumU& factor, const ThisType& r)
+  {
+    return r * factor;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType operator/(const NumU& divisor) const
+  {
+    ThisType result;
+    for (std::size_t i = 0; i < Lanes; ++i) result.v[i] = this->v[i] / divisor;
+    return result;
+  }
+
+  // Scaling by a measurement gives a vector in the units every component would have on its own,
+  // Like a vector of meters per second times seconds being a vector of meters
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr auto operator*(const M& other) const
+  {
+    return ThisType::scaled(*this, [&other](const Element& e) { return e * other; });
+  }
+
+  template<typename M, IfMeasurement<M> = 0>
+  friend constexpr auto operator*(const M& l, const ThisType& r)
+  {
+    return ThisType::scaled(r, [&l](const Element& e) { return l * e; });
+  }
+
+  template<typename M, IfMeasurement<M> = 0>
+  constexpr auto operator/(const M& other) const
+  {
+    return ThisType::scaled(*this, [&other](const Element& e) { return e / other; });
+  }
+
+  // Assignment operators
+  template<typename V, IfConvertibleVector<V> = 0>
+  constexpr ThisType& operator+=(const V& other)
+  {
+    return *this = *this + other;
+  }
+
+  template<typename V, IfConvertibleVector<V> = 0>
+  constexpr ThisType& operator-=(const V& other)
+  {
+    return *this = *this - other;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType& operator*=(const NumU& factor)
+  {
+    return *this = *this * factor;
+  }
+
+  template<typename NumU, IfScalar<NumU> = 0>
+  constexpr ThisType& operator/=(const NumU& divisor)
+  {
+    return *this = *this / divisor;
+  }
+
+  // Comparison operators
+  // Vectors in different units are compared in this one's
+  template<typename V, IfConvertibleVector<V> = 0>
+  constexpr bool operator==(const V& other) const
+  {
+    ThisType converted(other);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      if (this->v[i] != converted.v[i]) return false;
+    }
+
+    return true;
+  }
+
+  template<typename V, IfConvertibleVector<V> = 0>
+  constexpr bool operator!=(const V& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  template<typename NumU, DimensionVector DimensionsU, std::size_t NU>
+  friend class BasicMeasurementVector;
+
+  alignas(Layout::Alignment) NumT v[Lanes] = {};
+
+  // Applies op to every component, where op multiplies or divides it by the same measurement
+  // With floating point values, op only scales the value it's given, so it's worked out once for a component of 1
+  // And the vector is multiplied by that; integers go one component at a time so they round like measurements do.
+  template<typename Op>
+  static constexpr auto scaled(const ThisType& vector, Op op)
+  {
+    using Component = decltype(op(std::declval<const Element&>()));
+    using Result = Private::VectorOf<Component, N>;
+    using ResultValue = typename Result::ValueType;
+
+    Result result;
+
+    if constexpr (std::is_floating_point_v<ResultValue>)
+    {
+      ResultValue factor = Private::bareValue(op(Element(NumT(1))));
+      for (std::size_t i = 0; i < Lanes; ++i) result.v[i] = static_cast<ResultValue>(vector.v[i]) * factor;
+    }
+    else
+    {
+      for (std::size_t i = 0; i < N; ++i) result.v[i] = Private::bareValue(op(vector[i]));
+    }
+
+    return result;
+  }
+};
+
+// A vector of N measurements of type M, like Vec<Meters<float>, 3>
+template<typename M, std::size_t N>
+using Vec = Private::VectorOf<M, N>;
+
+template<typename M>
+using Vec2 = Vec<M, 2>;
+
+template<typename M>
+using Vec3 = Vec<M, 3>;
+
+template<typename M>
+using Vec4 = Vec<M, 4>;
+
+namespace Private
+{
+
+// If both types are vectors of the same size, operators that use this type may be called
+template<typename L, typename R, typename T = int>
+using IfVectorPair = std::enable_if_t
+<
+  IsMeasurementVector<L>::value && IsMeasurementVector<R>::value && L::Size == R::Size,
+  T
+>;
+
+// The scale between the product of 2 bare values and the value of the product of the components they stand for
+// Measurements only scale the product of their values, so with floating point values this is applied once at the end.
+template<typename L, typename R>
+constexpr auto productScale()
+{
+  using Product = decltype(std::declval<const typename L::Element&>() * std::declval<const typename R::Element&>());
+  using ValueType = BareValueType<Product>;
+  return static_cast<ValueType>(Private::bareValue(typename L::Element(1) * typename R::Element(1)));
+}
+
+}
+
+// The sum of the products of the components, measured like l[i] * r[i] would be, so 2 vectors of meters give square meters
+template<typename L, typename R, Private::IfVectorPair<L, R> = 0>
+constexpr auto dot(const L& l, const R& r)
+{
+  using Result = decltype(l[0] * r[0]);
+  using ValueType = Private::BareValueType<Result>;
+
+  ValueType total = 0;
+
+  if constexpr (std::is_floating_point_v<ValueType>)
+  {
+    constexpr ValueType Scale = Private::productScale<L, R>();
+    const auto* lValues = l.data();
+    const auto* rValues = r.data();
+
+    for (std::size_t i = 0; i < L::Size; ++i) total += static_cast<ValueType>(lValues[i]) * static_cast<ValueType>(rValues[i]);
+    return Result(Scale == 1 ? total : total * Scale);
+  }
+  else
+  {
+    for (std::size_t i = 0; i < L::Size; ++i) total += Private::bareValue(l[i] * r[i]);
+    return Result(total);
+  }
+}
+
+// The cross product of 2 three-vectors, whose components are measured like l[i] * r[i] would be
+template<typename L, typename R, Private::IfVectorPair<L, R> = 0>
+constexpr auto cross(const L& l, const R& r)
+{
+  static_assert(L::Size == 3, "Only vectors with 3 components have a cross product.");
+
+  using Product = decltype(l[0] * r[0]);
+  using Result = Private::VectorOf<Product, 3>;
+  using ValueType = typename Result::ValueType;
+
+  if constexpr (std::is_floating_point_v<ValueType>)
+  {
+    constexpr ValueType Scale = Private::productScale<L, R>();
+    const auto* a = l.data();
+    const auto* b = r.data();
+
+    auto component = [a, b](std::size_t i, std::size_t j)
+    {
+      ValueType value = static_cast<ValueType>(a[i]) * static_cast<ValueType>(b[j]) -
+                        static_cast<ValueType>(a[j]) * static_cast<ValueType>(b[i]);
+      return Scale == 1 ? value : value * Scale;
+    };
+
+    return Result::fromValues({component(1, 2), component(2, 0), component(0, 1)});
+  }
+  else
+  {
+    return Result(l[1] * r[2] - l[2] * r[1], l[2] * r[0] - l[0] * r[2], l[0] * r[1] - l[1] * r[0]);
+  }
+}
+
+// The length of a vector, in its units
+template<typename V, std::enable_if_t<Private::IsMeasurementVector<V>::value, int> = 0>
+constexpr typename V::Element norm(const V& vector)
+{
+  using ValueType = typename V::ValueType;
+  static_assert(std::is_floating_point_v<ValueType>, "Only vectors with floating point values have a norm.");
+
+  const ValueType* values = vector.data();
+  ValueType total = 0;
+  for (std::size_t i = 0; i < V::Size; ++i) total += values[i] * values[i];
+
+  return typename V::Element(Private::Math::root<2>(total));
+}
+
+// Many vectors of N measurements, kept a component at a time
+// Component c of every vector is in component(c), which is an ordinary MeasurementArray,
+// So anything arrays do (expressions, conversions, reductions over values()) works on one component of all of them.
+template<typename NumT, DimensionVector DimensionsV, std::size_t N, typename AllocatorT>
+class BasicVectorBatch
+{
+public:
+  using ValueType = NumT;
+  static constexpr DimensionVector Dimensions = DimensionsV;
+  static constexpr std::size_t Size = N;
+
+  using Component = BasicMeasurementArray<NumT, DimensionsV, AllocatorT>;
+
+  // What a single vector is read as
+  using Element = BasicMeasurementVector<NumT, DimensionsV, N>;
+
+  BasicVectorBatch() = default;
+
+  explicit BasicVectorBatch(std::size_t size, const AllocatorT& allocator = AllocatorT())
+    : BasicVectorBatch(size, allocator, std::make_index_sequence<N>())
+  {}
+
+  std::size_t size() const { return this->components[0].size(); }
+  bool empty() const { return this->components[0].empty(); }
+
+  void reserve(std::size_t capacity)
+  {
+    for (Component& c : this->components) c.reserve(capacity);
+  }
+
+  void resize(std::size_t size)
+  {
+    for (Component& c : this->components) c.resize(size);
+  }
+
+  void clear()
+  {
+    for (Component& c : this->components) c.clear();
+  }
+
+  template<typename V, std::enable_if_t<std::is_convertible_v<const V&, Element>, int> = 0>
+  void push_back(const V& vector)
+  {
+    Element converted(vector);
+    for (std::size_t c = 0; c < N; ++c) this->components[c].push_back(converted[c]);
+  }
+
+  // Gathers the vector at i
+  Element operator[](std::size_t i) const
+  {
+    std::array<NumT, N> values;
+    for (std::size_t c = 0; c < N; ++c) values[c] = this->components[c].data()[i];
+    return Element::fromValues(values);
+  }
+
+  // Scatters a vector into i, converting it into this batch's units
+  template<typename V, std::enable_if_t<std::is_convertible_v<const V&, Element>, int> = 0>
+  void set(std::size_t i, const V& vector)
+  {
+    Element converted(vector);
+    for (std::size_t c = 0; c < N; ++c) this->components[c].data()[i] = converted.data()[c];
+  }
+
+  Component& component(std::size_t c) { return this->components[c]; }
+  const Component& component(std::size_t c) const { return this->components[c]; }
+
+  Component& x() requires (N >= 1) { return this->components[0]; }
+  Component& y() requires (N >= 2) { return this->components[1]; }
+  Component& z() requires (N >= 3) { return this->components[2]; }
+  Component& w() requires (N >= 4) { return this->components[3]; }
+
+  const Component& x() const requires (N >= 1) { return this->components[0]; }
+  const Component& y() const requires (N >= 2) { return this->components[1]; }
+  const Component& z() const requires (N >= 3) { return this->components[2]; }
+  const Component& w() const requires (N >= 4) { return this->components[3]; }
+
+private:
+  std::array<Component, N> components;
+
+  template<std::size_t... Cs>
+  BasicVectorBatch(std::size_t size, const AllocatorT& allocator, std::index_sequence<Cs...>)
+    : components{((void)Cs, Component(size, allocator))...}
+  {}
+};
+
+// Many vectors of N measurements of type M, like VectorBatch<Meters<float>, 3>
+template<typename M, std::size_t N>
+using VectorBatch = typename Private::BatchOf_<M, N>::Type;
+
+namespace Private
+{
+
+template<typename T>
+struct IsVectorBatch : std::false_type {};
+
+template<typename NumT, DimensionVector DimensionsV, std::size_t N, typename AllocatorT>
+struct IsVectorBatch<BasicVectorBatch<NumT, DimensionsV, N, AllocatorT>> : std::true_type {};
+
+// If both types are batches of vectors of the same size, functions that use this type may be called
+template<typename L, typename R, typename T = int>
+using IfBatchPair = std::enable_if_t
+<
+  IsVectorBatch<L>::value && IsVectorBatch<R>::value && L::Size == R::Size,
+  T
+>;
+
+template<typename L, typename R, std::size_t... Cs>
+auto dotOf(const L& l, const R& r, std::index_sequence<Cs...>)
+{
+  return ((l.component(Cs) * r.component(Cs)) + ...);
+}
+
+}
+
+// The dot product of every pair of vectors, as an expression of their components (see MetaMeasure/Expression.hpp)
+// Assigning it to an array evaluates it in a single loop over all of them.
+// It only refers to the batches, so it shouldn't outlive them.
+template<typename L, typename R, Private::IfBatchPair<L, R> = 0>
+auto dot(const L& l, const R& r)
+{
+  return Private::dotOf(l, r, std::make_index_sequence<L::Size>());
+}
+
+// The cross product of every pair of three-vectors, in a new batch
+template<typename L, typename R, Private::IfBatchPair<L, R> = 0>
+auto cross(const L& l, const R& r)
+{
+  static_assert(L::Size == 3, "Only vectors with 3 components have a cross product.");
+
+  using Product = decltype(std::declval<const typename L::Component::Element&>() *
+                           std::declval<const typename R::Component::Element&>());
+  static_assert(Private::IsMeasurement<Product>::value, "A cross product without dimensions doesn't fit in a batch of measurements.");
+
+  constexpr DimensionVector Dimensions = Product::Dimensions;
+  BasicVectorBatch<typename Product::ValueType, Dimensions, 3, typename L::Component::AllocatorType> result;
+
+  result.x() = l.y() * r.z() - l.z() * r.y();
+  result.y() = l.z() * r.x() - l.x() * r.z();
+  result.z() = l.x() * r.y() - l.y() * r.x();
+  return result;
+}
+
+// The length of every vector, in their units
+template<typename B, std::enable_if_t<Private::IsVectorBatch<B>::value, int> = 0>
+typename B::Component norm(const B& batch)
+{
+  using ValueType = typename B::ValueType;
+  static_assert(std::is_floating_point_v<ValueType>, "Only vectors with floating point values have a norm.");
+
+  typename B::Component result(batch.size(), batch.component(0).allocator());
+  ValueType* METAMEASURE_RESTRICT out = result.data();
+  std::size_t size = batch.size();
+
+  // One component at a time, so every loop is over contiguous values
+  for (std::size_t c = 0; c < B::Size; ++c)
+  {
+    const ValueType* METAMEASURE_RESTRICT in = batch.component(c).data();
+
+    if (c == 0) for (std::size_t i = 0; i < size; ++i) out[i] = in[i] * in[i];
+    else for (std::size_t i = 0; i < size; ++i) out[i] += in[i] * in[i];
+  }
+
+  for (std::size_t i = 0; i < size; ++i) out[i] = Private::Math::root<2>(out[i]);
+  return result;
+}
+
+}
+
+#endif